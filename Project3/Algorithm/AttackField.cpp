@@ -0,0 +1,183 @@
+#include "AttackField.h"
+
+#include <algorithm>
+
+#include "MyBattleStatus.h"
+
+using UserCommon_123456789_987654321::BoardSnapshot;
+
+namespace {
+// Same thresholds as MyBattleStatus::isShellClose and isEnemyClose
+constexpr int SHELL_DANGER_RADIUS = 5;
+constexpr int ENEMY_DANGER_RADIUS = 2;
+}
+
+/**
+ * @brief Creates the field of a player for one board snapshot
+ *
+ * @param board Snapshot the field is computed from
+ * @param player_id Player whose tanks read the field (1 or 2)
+ */
+AttackField::AttackField(std::shared_ptr<const BoardSnapshot> board, const int player_id)
+    : board(std::move(board)),
+      ally(player_id == 1 ? '1' : '2'),
+      enemy(player_id == 1 ? '2' : '1'),
+      width(this->board->getWidth()),
+      height(this->board->getHeight()) {
+}
+
+/**
+ * @brief Row-major index of a position, wrapped onto the board
+ */
+size_t AttackField::cellOf(const Position p) const {
+    const int w = static_cast<int>(width);
+    const int h = static_cast<int>(height);
+    return static_cast<size_t>((p.y % h + h) % h) * width + static_cast<size_t>((p.x % w + w) % w);
+}
+
+/**
+ * @brief Clears the safe flag of every cell within radius (max norm, wrapping) of (x, y)
+ */
+void AttackField::markDanger(const size_t x, const size_t y, const int radius) const {
+    const size_t span_x = std::min(static_cast<size_t>(2 * radius + 1), width);
+    const size_t span_y = std::min(static_cast<size_t>(2 * radius + 1), height);
+    const size_t first_x = (x + width * radius - radius) % width;
+    const size_t first_y = (y + height * radius - radius) % height;
+    for (size_t j = 0; j < span_y; j++) {
+        const size_t row = (first_y + j) % height * width;
+        for (size_t i = 0; i < span_x; i++) {
+            safe[row + (first_x + i) % width] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Marks every cell that sees the enemy at (x, y) along a straight line
+ *
+ * Walks away from the enemy in each direction, as far as a shot is traced by
+ * MyBattleStatus::isTargetOnSight, and stops after the first wall or ally.
+ * Every cell up to that blocker is marked anyway, so LineOfSight's bitboards
+ * would only find the blocker, not save the walk, and would need a layer of
+ * this player's blockers built on every snapshot.
+ */
+void AttackField::markFiringLines(const size_t x, const size_t y) const {
+    const size_t max_distance = std::max(width, height);
+    const Position target(x, y);
+    for (int i = 0; i < Direction::getDirectionSize(); i++) {
+        const auto dir = Direction::getDirectionFromIndex(i);
+        Position pos = target;
+        for (size_t step = 1; step <= max_distance; step++) {
+            pos = pos - dir;
+            const size_t cell = cellOf(pos);
+            firing[cell] = 1;
+            const char item = board->get(cell % width, cell / width);
+            if (item == MyBattleStatus::boardItemToChar(MyBattleStatus::BoardItem::WALL) || item == ally) break;
+        }
+    }
+}
+
+/**
+ * @brief Runs the reverse BFS from all safe firing positions at once
+ */
+void AttackField::build() const {
+    built = true;
+    const size_t cells = width * height;
+    safe.assign(cells, 0);
+    firing.assign(cells, 0);
+    distance.assign(cells, UNREACHED);
+    next_step.assign(cells, Direction::UP);
+
+    const char empty = MyBattleStatus::boardItemToChar(MyBattleStatus::BoardItem::EMPTY);
+    const char shell = MyBattleStatus::boardItemToChar(MyBattleStatus::BoardItem::SHELL);
+    for (size_t j = 0; j < height; j++) {
+        const char *row = board->row(j);
+        for (size_t i = 0; i < width; i++) {
+            safe[j * width + i] = row[i] == empty;
+        }
+    }
+    for (size_t j = 0; j < height; j++) {
+        const char *row = board->row(j);
+        for (size_t i = 0; i < width; i++) {
+            if (row[i] == shell) {
+                markDanger(i, j, SHELL_DANGER_RADIUS);
+            } else if (row[i] == enemy) {
+                markDanger(i, j, ENEMY_DANGER_RADIUS);
+                markFiringLines(i, j);
+            }
+        }
+    }
+
+    std::vector<uint32_t> queue;
+    queue.reserve(cells);
+    for (size_t cell = 0; cell < cells; cell++) {
+        if (firing[cell] && safe[cell]) {
+            distance[cell] = 0;
+            queue.push_back(static_cast<uint32_t>(cell));
+        }
+    }
+    for (size_t head = 0; head < queue.size(); head++) {
+        const uint32_t cell = queue[head];
+        const Position position(cell % width, cell / width);
+        for (int i = 0; i < Direction::getDirectionSize(); i++) {
+            const auto dir = Direction::getDirectionFromIndex(i);
+            // A tank moving along dir from `previous` lands on this cell
+            const size_t previous = cellOf(position - dir);
+            if (!safe[previous] || distance[previous] != UNREACHED) continue;
+            distance[previous] = distance[cell] + 1;
+            next_step[previous] = dir;
+            queue.push_back(static_cast<uint32_t>(previous));
+        }
+    }
+}
+
+/**
+ * @brief Checks whether an enemy is on a clear line from an on-board cell
+ *
+ * @param p Cell to check
+ * @return true If a shot fired from p in some direction reaches an enemy
+ */
+bool AttackField::isFiringPosition(const Position p) const {
+    if (width == 0 || height == 0) return false;
+    if (!built) build();
+    return firing[cellOf(p)] != 0;
+}
+
+/**
+ * @brief Shortest path over safe cells from start to a firing position
+ *
+ * The first move goes to the safe neighbour closest to a firing position (the
+ * first one in direction order on ties); after that the path follows the steps
+ * stored by the search.
+ *
+ * @param start Tank position, wrapped onto the board before stepping
+ * @return The directions to follow, empty if none was found or start already is a firing position
+ */
+std::vector<Direction::DirectionType> AttackField::pathFrom(const Position start) const {
+    if (width == 0 || height == 0) return {};
+    if (!built) build();
+    const bool on_board = start.x >= 0 && static_cast<size_t>(start.x) < width &&
+                          start.y >= 0 && static_cast<size_t>(start.y) < height;
+    if (on_board && firing[cellOf(start)]) return {};
+
+    uint32_t best_distance = UNREACHED;
+    Direction::DirectionType first = Direction::UP;
+    for (int i = 0; i < Direction::getDirectionSize(); i++) {
+        const auto dir = Direction::getDirectionFromIndex(i);
+        const size_t next = cellOf(start + dir);
+        if (safe[next] && distance[next] < best_distance) {
+            best_distance = distance[next];
+            first = dir;
+        }
+    }
+    if (best_distance == UNREACHED) return {};
+
+    std::vector<Direction::DirectionType> path;
+    path.reserve(best_distance + 1);
+    path.push_back(first);
+    for (size_t cell = cellOf(start + first); distance[cell] > 0;) {
+        const auto dir = next_step[cell];
+        path.push_back(dir);
+        cell = cellOf(Position(cell % width, cell / width) + dir);
+    }
+    return path;
+}
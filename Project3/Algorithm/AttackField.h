@@ -0,0 +1,71 @@
+#ifndef ATTACK_FIELD_H
+#define ATTACK_FIELD_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Direction.h"
+#include "../UserCommon/SatelliteSnapshot.h"
+
+/**
+ * @class AttackField
+ * @brief Distance to the nearest firing position, shared by all tanks of one player
+ *
+ * A firing position is a cell from which an enemy tank is on a clear straight line
+ * (walls and allied tanks block it). One multi-source BFS runs backwards from every
+ * safe firing position over the safe cells, leaving each cell with its distance and
+ * the first step towards the closest one. Every allied tank reads the same field, so
+ * the search runs once per player per board snapshot instead of once per tank.
+ *
+ * The field keeps its snapshot alive, which also keeps the game manager from patching
+ * that snapshot in place. The search itself runs on the first query.
+ *
+ * The snapshot shows every allied tank, the querying one included, with the ally mark,
+ * so a tank's own cell counts as a blocker of lines passing through it.
+ */
+class AttackField {
+public:
+    AttackField(std::shared_ptr<const UserCommon_123456789_987654321::BoardSnapshot> board, int player_id);
+
+    const std::shared_ptr<const UserCommon_123456789_987654321::BoardSnapshot> &getBoard() const { return board; }
+
+    /**
+     * @brief Checks whether an enemy is on a clear line from an on-board cell
+     */
+    bool isFiringPosition(Position p) const;
+
+    /**
+     * @brief Shortest path over safe cells from start to a firing position
+     *
+     * @param start Tank position, wrapped onto the board before stepping
+     * @return The directions to follow, empty if none was found or start already is a firing position
+     */
+    std::vector<Direction::DirectionType> pathFrom(Position start) const;
+
+private:
+    static constexpr uint32_t UNREACHED = UINT32_MAX;
+
+    std::shared_ptr<const UserCommon_123456789_987654321::BoardSnapshot> board;
+    char ally;
+    char enemy;
+    size_t width;
+    size_t height;
+
+    // Filled by build() on the first query
+    mutable bool built{false};
+    mutable std::vector<uint8_t> safe;                       ///< Empty and away from shells and enemies
+    mutable std::vector<uint8_t> firing;                     ///< An enemy is on a clear line from here
+    mutable std::vector<uint32_t> distance;                  ///< Moves to the nearest safe firing position
+    mutable std::vector<Direction::DirectionType> next_step; ///< First move on that path
+
+    void build() const;
+
+    void markDanger(size_t x, size_t y, int radius) const;
+
+    void markFiringLines(size_t x, size_t y) const;
+
+    size_t cellOf(Position p) const;
+};
+
+#endif //ATTACK_FIELD_H
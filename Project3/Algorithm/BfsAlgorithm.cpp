@@ -1,15 +1,9 @@
 #include "BfsAlgorithm.h"
 
-#include <queue>
-#include <set>
-#include <limits>
+#include <algorithm>
 #include "Logger.h"
 #include "Direction.h"
 
-// a boolean to indicate if we are stuck in the current BFS path and need to recompute the path
-bool tried_path_without_success = false;
-std::vector<Direction::DirectionType> current_path; // the current path we got from the BFS computation
-
 void PathfindingAlgorithm::initLatestEnemyPosition() {
     last_enemy_positions = std::vector<Position>(battle_status.getEnemyTankCounts(), {-1, -1});
 }
@@ -44,7 +38,7 @@ void PathfindingAlgorithm::tryShootEnemy(ActionRequest *request, std::string *re
     rotateToEnemy(request, request_title);
 }
 
-bool PathfindingAlgorithm::rotateToEnemy(ActionRequest *request, std::string *request_title) const {
+bool PathfindingAlgorithm::rotateToEnemy(ActionRequest *request, std::string *request_title) {
     // If the tank is not threatened and cannot shoot, try to rotate towards the enemy.
     for (auto dir_index = 0; dir_index < 8; ++dir_index) {
         Direction::DirectionType dir = Direction::getDirectionFromIndex(dir_index);
@@ -71,17 +65,19 @@ bool PathfindingAlgorithm::hasEnemyMoved() const {
 void PathfindingAlgorithm::updatePathIfNeeded() {
     const bool enemy_moved = hasEnemyMoved();
     if (current_path.empty() || enemy_moved || tried_path_without_success) {
-        const std::string reason = current_path.empty()
-                                       ? "empty"
-                                       : (enemy_moved ? "enemy moved" : "triedPathWithoutSuccess");
-        std::string msg = "Computing BFS (reason: " + reason + ")";
+        if constexpr (isLogLevelEnabled(LogLevel::Debug)) {
+            const std::string reason = current_path.empty()
+                                           ? "empty"
+                                           : (enemy_moved ? "enemy moved" : "triedPathWithoutSuccess");
+            printLogs("Computing BFS (reason: " + reason + ")");
+        }
         current_path = computeBFS();
         tried_path_without_success = current_path.empty();
         updateLatestEnemyPosition();
     }
 }
 
-void PathfindingAlgorithm::handleEmptyPath(ActionRequest *request, std::string *request_title) const {
+void PathfindingAlgorithm::handleEmptyPath(ActionRequest *request, std::string *request_title) {
     if (battle_status.canTankShoot()) {
         *request = ActionRequest::Shoot;
         tried_path_without_success = !battle_status.canTankHitEnemy();
@@ -136,45 +132,96 @@ void PathfindingAlgorithm::followPathOrRotate(ActionRequest *request, std::strin
 }
 
 
+/**
+ * @brief Finds the shortest safe path to a cell from which an enemy is on sight
+ *
+ * The search itself is shared: every tank of the player reads the same attack
+ * field, which is computed once per board snapshot. A tank whose player hands
+ * out no field (one other than BfsPlayer) searches on its own instead.
+ *
+ * @return The directions to follow, empty if none was found or the start already matches
+ */
 std::vector<Direction::DirectionType> PathfindingAlgorithm::computeBFS() {
-    struct Node {
-        Position pos;
-        std::vector<Direction::DirectionType> path;
+    if constexpr (isLogLevelEnabled(LogLevel::Debug)) {
+        printLogs("Calculating BFS. Start Position = " + battle_status.tank_position.toString());
+    }
 
-        Node(const Position &pos, const std::vector<Direction::DirectionType> &path): pos(pos), path(path) {
-        }
+    if (attack_field == nullptr) return searchOwnPath();
+
+    // There is nothing to aim at until the tank can shoot again
+    if (!battle_status.canTankShoot()) return {};
+    return attack_field->pathFrom(battle_status.tank_position);
+}
+
+/**
+ * @brief Finds the shortest safe path to a cell from which the enemy is on sight, from this tank alone
+ *
+ * Breadth-first search over board cells with parent links in flat arrays; the
+ * path is rebuilt from the parents once the first matching cell is dequeued.
+ * Cells are numbered y * width + x, with one extra slot past the board for a
+ * start position that is not on it.
+ *
+ * @return The directions to follow, empty if none was found or the start already matches
+ */
+std::vector<Direction::DirectionType> PathfindingAlgorithm::searchOwnPath() {
+    const size_t width = battle_status.board_x;
+    const size_t height = battle_status.board_y;
+    if (width == 0 || height == 0) return {};
+
+    const Position origin = battle_status.tank_position;
+    const auto off_board = static_cast<uint32_t>(width * height);
+    const bool on_board = origin.x >= 0 && static_cast<size_t>(origin.x) < width &&
+                          origin.y >= 0 && static_cast<size_t>(origin.y) < height;
+    const uint32_t start = on_board ? static_cast<uint32_t>(origin.y * width + origin.x) : off_board;
+    const size_t slots = width * height + 1;
+    if (workspace.visited_mark.size() != slots) {
+        workspace.visited_mark.assign(slots, 0);
+        workspace.parent.assign(slots, 0);
+        workspace.parent_dir.assign(slots, Direction::UP);
+        workspace.queue.assign(slots, 0);
+        workspace.generation = 0;
+    }
+    if (++workspace.generation == 0) {
+        std::fill(workspace.visited_mark.begin(), workspace.visited_mark.end(), 0);
+        workspace.generation = 1;
+    }
+    const uint32_t generation = workspace.generation;
+    auto positionOf = [&](const uint32_t cell) {
+        return cell == off_board
+                   ? origin
+                   : Position(static_cast<int>(cell % width), static_cast<int>(cell / width));
     };
-    std::string msg = "Calculating BFS. Start Position = " + battle_status.tank_position.toString();
-    printLogs(msg);
-
-    std::queue<Node> q;
-    std::set<Position> visited;
-    q.push(Node(battle_status.tank_position, {}));
-    std::vector<Direction::DirectionType> best_path;
-    size_t shortest_length = std::numeric_limits<size_t>::max();
-
-    while (!q.empty()) {
-        auto [position, path] = q.front();
-        q.pop();
-        if (visited.find(position) != visited.end()) continue;
-        visited.insert(position);
-        // checking if the next step in the queue can lead to shooting the enemy directly
+
+    size_t head = 0;
+    size_t tail = 0;
+    workspace.visited_mark[start] = generation;
+    workspace.queue[tail++] = start;
+
+    while (head < tail) {
+        const uint32_t cell = workspace.queue[head++];
+        const Position position = positionOf(cell);
+        // checking if this cell lets the tank shoot the enemy directly
         if (battle_status.canTankHitEnemy(position)) {
-            if (path.size() < shortest_length) {
-                best_path = path;
-                shortest_length = path.size();
+            std::vector<Direction::DirectionType> path;
+            for (uint32_t c = cell; c != start; c = workspace.parent[c]) {
+                path.push_back(workspace.parent_dir[c]);
             }
-            continue;
+            std::reverse(path.begin(), path.end());
+            return path;
         }
-        for (const auto dir: battle_status.getSafeDirections(position)) {
+        for (int i = 0; i < Direction::getDirectionSize(); i++) {
+            const auto dir = Direction::getDirectionFromIndex(i);
             const Position next = battle_status.updatePosition(position + dir);
-            if (visited.find(next) != visited.end()) continue;
-            std::vector<Direction::DirectionType> new_path = path;
-            new_path.push_back(dir);
-            q.push(Node(next, new_path));
+            const auto next_cell = static_cast<uint32_t>(next.y * width + next.x);
+            if (workspace.visited_mark[next_cell] == generation) continue;
+            if (!battle_status.isSafePosition(next)) continue;
+            workspace.visited_mark[next_cell] = generation;
+            workspace.parent[next_cell] = cell;
+            workspace.parent_dir[next_cell] = dir;
+            workspace.queue[tail++] = next_cell;
         }
     }
-    return best_path;
+    return {};
 }
 
 void PathfindingAlgorithm::calculateAction(ActionRequest *request, std::string *request_title) {
@@ -1,6 +1,8 @@
 #ifndef PATHFINDINGALGORITHM_H
 #define PATHFINDINGALGORITHM_H
 
+#include <cstdint>
+
 #include "Direction.h"
 #include "MyTankAlgorithm.h"
 
@@ -15,8 +17,25 @@ public:
     void calculateAction(ActionRequest *request, std::string *request_title) override;
 
 private:
+    /**
+     * Flat BFS state sized to the board and reused by every search of this tank.
+     * A cell is visited in the current search when its mark equals generation,
+     * so nothing has to be cleared between searches.
+     */
+    struct SearchWorkspace {
+        std::vector<uint32_t> visited_mark;
+        std::vector<uint32_t> parent;                     ///< Cell each visited cell was reached from
+        std::vector<Direction::DirectionType> parent_dir; ///< Step taken from the parent cell
+        std::vector<uint32_t> queue;
+        uint32_t generation{0};
+    };
+
     bool was_threatened{false};
+    // Set when the current BFS path led nowhere and has to be recomputed
+    bool tried_path_without_success{false};
+    std::vector<Direction::DirectionType> current_path; // the current path we got from the BFS computation
     std::vector<Position> last_enemy_positions = {};
+    SearchWorkspace workspace; ///< Only used without a player-wide attack field
 
     void initLatestEnemyPosition();
 
@@ -26,16 +45,18 @@ private:
 
     void tryShootEnemy(ActionRequest *request, std::string *request_title);
 
-    bool rotateToEnemy(ActionRequest *request, std::string *request_title) const;
+    bool rotateToEnemy(ActionRequest *request, std::string *request_title);
 
     void updatePathIfNeeded();
 
-    void handleEmptyPath(ActionRequest *request, std::string *request_title) const;
+    void handleEmptyPath(ActionRequest *request, std::string *request_title);
 
     void followPathOrRotate(ActionRequest *request, std::string *request_title);
 
     std::vector<Direction::DirectionType> computeBFS();
 
+    std::vector<Direction::DirectionType> searchOwnPath();
+
     bool hasEnemyMoved() const;
 };
 
@@ -2,16 +2,57 @@
 
 #include "MyBattleInfo.h"
 
+using UserCommon_123456789_987654321::BoardSnapshot;
+using UserCommon_123456789_987654321::SnapshotSatelliteView;
+
 void BfsPlayer::updateTankWithBattleInfo(TankAlgorithm &tank, SatelliteView &satellite_view) {
-    auto battle_info = MyBattleInfo(createBoardFromSatellite(satellite_view), player_index, max_steps, shells_count);
+    // Our own game manager shares its snapshot, so there is nothing to copy
+    if (const auto snapshot_view = dynamic_cast<const SnapshotSatelliteView *>(&satellite_view)) {
+        const auto &snapshot = snapshot_view->getSnapshot();
+        auto battle_info = MyBattleInfo(snapshot, snapshot_view->getSelfX(), snapshot_view->getSelfY(),
+                                        player_index, max_steps, shells_count, attackFieldFor(snapshot));
+        tank.updateBattleInfo(battle_info);
+        return;
+    }
+
+    // The copy shows the requesting tank as an ally, so tanks of the same step get identical copies
+    size_t self_x = x;
+    size_t self_y = y;
+    auto board = createBoardFromSatellite(satellite_view, self_x, self_y);
+    if (attack_field != nullptr && *attack_field->getBoard() == *board) {
+        board = attack_field->getBoard();
+    }
+    auto battle_info = MyBattleInfo(board, self_x, self_y, player_index, max_steps, shells_count,
+                                    attackFieldFor(board));
     tank.updateBattleInfo(battle_info);
 }
 
-std::vector<std::vector<char> > BfsPlayer::createBoardFromSatellite(const SatelliteView &satellite_view) const {
-    std::vector board(x, std::vector<char>(y));
-    for (size_t i{0}; i < x; i++) {
-        for (size_t j{0}; j < y; j++) {
-            board[i][j] = satellite_view.getObject(i, j);
+/**
+ * @brief Returns the attack field of a snapshot, computing a new one only when the snapshot changed
+ *
+ * The field holds on to its snapshot, so the game manager never patches it
+ * in place and comparing the pointers is enough.
+ */
+const std::shared_ptr<const AttackField> &BfsPlayer::attackFieldFor(const std::shared_ptr<const BoardSnapshot> &snapshot) {
+    if (attack_field == nullptr || attack_field->getBoard() != snapshot) {
+        attack_field = std::make_shared<AttackField>(snapshot, player_index);
+    }
+    return attack_field;
+}
+
+std::shared_ptr<const BoardSnapshot> BfsPlayer::createBoardFromSatellite(const SatelliteView &satellite_view,
+                                                                         size_t &self_x, size_t &self_y) const {
+    const char ally = player_index == 1 ? '1' : '2';
+    auto board = std::make_shared<BoardSnapshot>(x, y);
+    for (size_t j{0}; j < y; j++) {
+        char *row = board->row(j);
+        for (size_t i{0}; i < x; i++) {
+            row[i] = satellite_view.getObject(i, j);
+            if (row[i] == SnapshotSatelliteView::SELF) {
+                row[i] = ally;
+                self_x = i;
+                self_y = j;
+            }
         }
     }
     return board;
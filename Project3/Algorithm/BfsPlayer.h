@@ -1,8 +1,10 @@
 #ifndef BFSPLAYER_H
 #define BFSPLAYER_H
-#include <vector>
+#include <memory>
 
+#include "AttackField.h"
 #include "Player.h"
+#include "../UserCommon/SatelliteSnapshot.h"
 
 class BfsPlayer final : public Player {
     int player_index;
@@ -10,8 +12,14 @@ class BfsPlayer final : public Player {
     size_t y;
     size_t max_steps;
     size_t shells_count;
+    // Field of the last snapshot seen, shared by every tank of this player until the board changes
+    std::shared_ptr<const AttackField> attack_field;
 
-    std::vector<std::vector<char> > createBoardFromSatellite(const SatelliteView &satellite_view) const;
+    std::shared_ptr<const UserCommon_123456789_987654321::BoardSnapshot> createBoardFromSatellite(
+        const SatelliteView &satellite_view, size_t &self_x, size_t &self_y) const;
+
+    const std::shared_ptr<const AttackField> &attackFieldFor(
+        const std::shared_ptr<const UserCommon_123456789_987654321::BoardSnapshot> &snapshot);
 
 public:
     BfsPlayer(int player_index,
@@ -0,0 +1,171 @@
+#include "LineOfSight.h"
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace {
+constexpr uint32_t UNASSIGNED = UINT32_MAX;
+}
+
+/**
+ * @brief Prepares an empty set of layers for a board of the given size
+ *
+ * @param width Board width
+ * @param height Board height
+ */
+void LineOfSight::reset(const size_t width, const size_t height) {
+    if (width != this->width || height != this->height || geometry == nullptr) {
+        this->width = width;
+        this->height = height;
+        geometry = geometryFor(width, height);
+        for (size_t f = 0; f < blockers.size(); f++) {
+            const LineFamily &family = geometry->families[f];
+            const size_t lines = family.length == 0 ? 0 : width * height / family.length;
+            blockers[f].assign(lines * family.words, 0);
+        }
+        return;
+    }
+
+    for (auto &bits: blockers) {
+        std::fill(bits.begin(), bits.end(), 0);
+    }
+}
+
+/**
+ * @brief Returns the line geometry of a board size, building it on first use
+ *
+ * Geometries are kept while some LineOfSight uses them, so boards of one size
+ * share a single copy across tanks, players and concurrent games.
+ */
+std::shared_ptr<const LineOfSight::Geometry> LineOfSight::geometryFor(const size_t width, const size_t height) {
+    static std::mutex mutex;
+    static std::map<std::pair<size_t, size_t>, std::weak_ptr<const Geometry> > cache;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::weak_ptr<const Geometry> &cached = cache[{width, height}];
+    if (auto geometry = cached.lock()) return geometry;
+
+    auto geometry = std::make_shared<Geometry>();
+    buildFamily(geometry->families[ROWS], width, height, 1, 0);
+    buildFamily(geometry->families[COLUMNS], width, height, 0, 1);
+    buildFamily(geometry->families[DIAGONALS], width, height, 1, 1);
+    buildFamily(geometry->families[ANTI_DIAGONALS], width, height, 1, -1);
+    cached = geometry;
+    return geometry;
+}
+
+/**
+ * @brief Splits the board into the cycles traced by repeatedly stepping (dx, dy)
+ *
+ * @param family Family to fill
+ * @param width Board width
+ * @param height Board height
+ * @param dx Step along x
+ * @param dy Step along y
+ */
+void LineOfSight::buildFamily(LineFamily &family, const size_t width, const size_t height, const int dx,
+                              const int dy) {
+    const size_t cells = width * height;
+    family.line_of.assign(cells, UNASSIGNED);
+    family.index_of.assign(cells, 0);
+    family.length = 0;
+
+    const int w = static_cast<int>(width);
+    const int h = static_cast<int>(height);
+    uint32_t lines = 0;
+    for (size_t start = 0; start < cells; start++) {
+        if (family.line_of[start] != UNASSIGNED) continue;
+
+        const uint32_t line = lines++;
+        int x = static_cast<int>(start % width);
+        int y = static_cast<int>(start / width);
+        uint32_t index = 0;
+        for (size_t cell = start; family.line_of[cell] == UNASSIGNED; index++) {
+            family.line_of[cell] = line;
+            family.index_of[cell] = index;
+            x = (x + dx + w) % w;
+            y = (y + dy + h) % h;
+            cell = static_cast<size_t>(y) * width + x;
+        }
+        family.length = index;
+    }
+    family.words = (family.length + 63) / 64;
+}
+
+/**
+ * @brief Marks a cell as blocking the line of sight on every line through it
+ *
+ * @param p Position of the blocking cell
+ */
+void LineOfSight::addBlocker(const Position p) {
+    const size_t cell = static_cast<size_t>(p.y) * width + p.x;
+    for (size_t f = 0; f < blockers.size(); f++) {
+        const LineFamily &family = geometry->families[f];
+        const uint32_t index = family.index_of[cell];
+        blockers[f][family.line_of[cell] * family.words + index / 64] |= uint64_t{1} << (index % 64);
+    }
+}
+
+/**
+ * @brief Checks whether any bit is set in `count` consecutive cells of a cyclic line, starting at `from`
+ */
+bool LineOfSight::anyInRange(const uint64_t *bits, const size_t length, size_t from, size_t count) {
+    while (count > 0) {
+        // Take the part of the range that does not wrap past the end of the line
+        const size_t to = std::min(length, from + count);
+        count -= to - from;
+
+        size_t lo = from;
+        while (lo < to) {
+            const size_t word = lo / 64;
+            const size_t bit = lo % 64;
+            const size_t span = std::min<size_t>(64 - bit, to - lo);
+            const uint64_t mask = (span == 64 ? ~uint64_t{0} : ((uint64_t{1} << span) - 1)) << bit;
+            if (bits[word] & mask) return true;
+            lo += span;
+        }
+        from = 0;
+    }
+    return false;
+}
+
+/**
+ * @brief Checks whether target is reached from `from` along dir within max_steps, before any blocker
+ *
+ * @param from Starting position (not itself checked)
+ * @param target Position to reach
+ * @param dir Direction of travel
+ * @param max_steps Maximum number of steps taken
+ * @return true If target is reached first
+ */
+bool LineOfSight::isClear(const Position from, const Position target, const Direction::DirectionType dir,
+                          const size_t max_steps) const {
+    const Position delta = Direction::getDirectionDelta(dir);
+    Family kind;
+    if (delta.y == 0) kind = ROWS;
+    else if (delta.x == 0) kind = COLUMNS;
+    else if (delta.x == delta.y) kind = DIAGONALS;
+    else kind = ANTI_DIAGONALS;
+    // Families are built stepping right (or down for columns); the other half of the directions walk backwards
+    const bool forward = kind == COLUMNS ? delta.y > 0 : delta.x > 0;
+
+    const LineFamily &family = geometry->families[kind];
+    const size_t from_cell = static_cast<size_t>(from.y) * width + from.x;
+    const size_t target_cell = static_cast<size_t>(target.y) * width + target.x;
+    if (family.line_of[from_cell] != family.line_of[target_cell]) return false;
+
+    const size_t length = family.length;
+    const size_t p = family.index_of[from_cell];
+    const size_t q = family.index_of[target_cell];
+    size_t steps = forward ? (q + length - p) % length : (p + length - q) % length;
+    // A target on the starting cell is only reached after going all the way around the line
+    if (steps == 0) steps = length;
+    if (steps > max_steps) return false;
+
+    // Cells strictly between the two positions, listed in increasing line order
+    const size_t first = forward ? (p + 1) % length : (q + 1) % length;
+    const uint64_t *line = blockers[kind].data() + family.line_of[from_cell] * family.words;
+    return !anyInRange(line, length, first, steps - 1);
+}
@@ -0,0 +1,73 @@
+#ifndef LINE_OF_SIGHT_H
+#define LINE_OF_SIGHT_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Direction.h"
+
+/**
+ * @class LineOfSight
+ * @brief Bit-packed blocker layers for line-of-sight queries on the wrapping board
+ *
+ * Every straight line a shell can travel on the torus is a cycle of cells:
+ * rows, columns, and the two diagonal families (whose cycles are lcm(width, height)
+ * long and there are gcd(width, height) of each). Each cycle keeps one bit per
+ * cell marking blockers, so checking the cells between a tank and its target is a
+ * scan of 64 cells per word instead of one cell per step.
+ *
+ * Which line each cell is on depends only on the board size, so that geometry is
+ * built once per size and shared by every LineOfSight in the process; each one
+ * only owns its blocker bits.
+ */
+class LineOfSight {
+public:
+    /**
+     * @brief Prepares an empty set of layers for a board of the given size
+     *
+     * The line geometry is only looked up again when the board size changes.
+     */
+    void reset(size_t width, size_t height);
+
+    /**
+     * @brief Marks a cell as blocking the line of sight on every line through it
+     */
+    void addBlocker(Position p);
+
+    /**
+     * @brief Checks whether target is reached from `from` moving along dir, within max_steps steps
+     * and before any blocker. Both positions must be on the board.
+     */
+    bool isClear(Position from, Position target, Direction::DirectionType dir, size_t max_steps) const;
+
+private:
+    // One family of parallel lines (rows, columns, diagonals or anti-diagonals)
+    struct LineFamily {
+        size_t length{0};                       ///< Cells on each line
+        size_t words{0};                        ///< Blocker words per line
+        std::vector<uint32_t> line_of;          ///< Line through each cell (row-major)
+        std::vector<uint32_t> index_of;         ///< Index of each cell on its line
+    };
+
+    enum Family { ROWS, COLUMNS, DIAGONALS, ANTI_DIAGONALS };
+
+    // Line geometry of one board size, shared read-only between threads
+    struct Geometry {
+        std::array<LineFamily, 4> families;
+    };
+
+    size_t width{0};
+    size_t height{0};
+    std::shared_ptr<const Geometry> geometry;
+    std::array<std::vector<uint64_t>, 4> blockers; ///< One bit per cell, `words` words per line
+
+    static std::shared_ptr<const Geometry> geometryFor(size_t width, size_t height);
+
+    static void buildFamily(LineFamily &family, size_t width, size_t height, int dx, int dy);
+
+    static bool anyInRange(const uint64_t *bits, size_t length, size_t from, size_t count);
+};
+
+#endif //LINE_OF_SIGHT_H
@@ -1,9 +1,11 @@
 #ifndef GAMESTATE_H
 #define GAMESTATE_H
 
-#include <vector>
+#include <memory>
+#include "AttackField.h"
 #include "BattleInfo.h"
 #include "Logger.h"
+#include "../UserCommon/SatelliteSnapshot.h"
 
 /**
  * @class MyBattleInfo
@@ -15,8 +17,12 @@
  * can use to make decisions.
  */
 class MyBattleInfo final : public BattleInfo {
-    // 2D representation of the game board using characters
-    std::vector<std::vector<char> > board{};
+    // Shared board snapshot; the tank's own cell is given separately by self_x/self_y
+    std::shared_ptr<const UserCommon_123456789_987654321::BoardSnapshot> board;
+    size_t self_x;
+    size_t self_y;
+    // Player-wide attack field of this snapshot, null if the sender has none
+    std::shared_ptr<const AttackField> attack_field;
     // Maximum number of steps allowed in a game
     size_t max_steps;
     // Number of shells available to a player
@@ -25,22 +31,35 @@ class MyBattleInfo final : public BattleInfo {
 public:
     /**
      * @brief Constructor for MyBattleInfo
-     * @param board A 2D vector representing the game board
+     * @param board Snapshot of the game board
+     * @param self_x X coordinate of the requesting tank (past the board width if it is marked in the snapshot)
+     * @param self_y Y coordinate of the requesting tank
      * @param player_id The ID of the player
      * @param max_steps Maximum number of steps allowed in the game
      * @param shells_count Number of shells available to the player
+     * @param attack_field Field computed by the player for this snapshot
      */
-    explicit MyBattleInfo(const std::vector<std::vector<char> > &board, const int player_id, size_t max_steps,
-                          const size_t shells_count): board(board), max_steps(max_steps), shells_count(shells_count) {
+    explicit MyBattleInfo(std::shared_ptr<const UserCommon_123456789_987654321::BoardSnapshot> board,
+                          const size_t self_x, const size_t self_y, const int player_id, size_t max_steps,
+                          const size_t shells_count,
+                          std::shared_ptr<const AttackField> attack_field = nullptr)
+        : board(std::move(board)), self_x(self_x), self_y(self_y), attack_field(std::move(attack_field)),
+          max_steps(max_steps), shells_count(shells_count) {
         // Log the player ID for debugging purposes
-        Logger::getInstance().log("Player_id: " + std::to_string(player_id));
+        LOG_DEBUG(Logger::current(), "Player_id: " + std::to_string(player_id));
     }
 
     /**
      * @brief Get the current state of the game board
-     * @return A constant reference to the 2D game board
+     * @return The shared board snapshot
      */
-    const std::vector<std::vector<char> > &getBoard() const { return board; }
+    const std::shared_ptr<const UserCommon_123456789_987654321::BoardSnapshot> &getBoard() const { return board; }
+
+    size_t getSelfX() const { return self_x; }
+
+    size_t getSelfY() const { return self_y; }
+
+    const std::shared_ptr<const AttackField> &getAttackField() const { return attack_field; }
     
     /**
      * @brief Get the number of shells available to the player
@@ -1,5 +1,7 @@
 #include "MyBattleStatus.h"
 
+#include <algorithm>
+
 #include "Direction.h"
 
 /**
@@ -28,12 +30,19 @@ MyBattleStatus::MyBattleStatus(int player_id, int tank_index): tank_direction(
  * Updates the internal board state with the new provided board,
  * recalculates the board dimensions, and refreshes tank positions.
  * 
+ * The snapshot is shared with the game manager and is kept, not copied.
+ * 
  * @param updated_board The new board state to update with
+ * @param self_x X coordinate of this tank's own cell (past the board width if it is marked in the snapshot)
+ * @param self_y Y coordinate of this tank's own cell
  */
-void MyBattleStatus::updateBoard(const std::vector<std::vector<char> > &updated_board) {
-    board = updated_board;
-    board_x = board.size();
-    board_y = board[0].size();
+void MyBattleStatus::updateBoard(std::shared_ptr<const UserCommon_123456789_987654321::BoardSnapshot> updated_board,
+                                 const size_t self_x, const size_t self_y) {
+    board = std::move(updated_board);
+    this->self_x = self_x;
+    this->self_y = self_y;
+    board_x = board->getWidth();
+    board_y = board->getHeight();
     updateTanksPosition();
 }
 
@@ -76,7 +85,10 @@ bool MyBattleStatus::canTankShoot() const {
  * @return char The character at the specified position
  */
 char MyBattleStatus::getBoardItem(int x, int y) const {
-    return board[x][y];
+    if (static_cast<size_t>(x) == self_x && static_cast<size_t>(y) == self_y) {
+        return boardItemToChar(BoardItem::CURRENT_TANK);
+    }
+    return board->get(x, y);
 }
 
 /**
@@ -99,7 +111,9 @@ char MyBattleStatus::getBoardItem(Position p) const {
  * @return Position The updated position after wrapping around the board
  */
 Position MyBattleStatus::updatePosition(Position p) const {
-    return {p.x % board_x, p.y % board_y};
+    const int w = static_cast<int>(board_x);
+    const int h = static_cast<int>(board_y);
+    return {(p.x % w + w) % w, (p.y % h + h) % h};
 }
 
 /**
@@ -190,7 +204,8 @@ bool MyBattleStatus::canTankHitEnemy(bool include_shells) const {
  * @brief Checks if a target is in the line of sight from the tank's position
  * 
  * Traces a line from the tank's position in the specified direction and checks
- * if the target is reached before any obstacle (wall or ally).
+ * if the target is reached before any obstacle (wall or ally). The obstacles are
+ * kept as bitboards built in updateTanksPosition, so the trace is a few word tests.
  * 
  * @param dir Direction to look in
  * @param target Position of the target to check
@@ -198,13 +213,21 @@ bool MyBattleStatus::canTankHitEnemy(bool include_shells) const {
  * @return false If an obstacle blocks the line of sight or the target is not in that direction
  */
 bool MyBattleStatus::isTargetOnSight(Direction::DirectionType dir, Position target) const {
+    const size_t max_distance = std::max(board_x, board_y);
+    if (tank_position.x >= 0 && static_cast<size_t>(tank_position.x) < board_x &&
+        tank_position.y >= 0 && static_cast<size_t>(tank_position.y) < board_y) {
+        return line_of_sight.isClear(tank_position, target, dir, max_distance);
+    }
+
+    // Own position unknown, walk the line cell by cell
     Position pos = tank_position;
-    for (size_t i = 1; i <= std::max(board_x, board_y); i++) {
+    for (size_t i = 1; i <= max_distance; i++) {
         pos = updatePosition(pos + dir);
         if (target == pos) {
             return true;
         }
-        if (board[pos.x][pos.y] == boardItemToChar(BoardItem::WALL) || board[pos.x][pos.y] == getAllyName()) {
+        const char item = getBoardItem(pos);
+        if (item == boardItemToChar(BoardItem::WALL) || item == getAllyName()) {
             return false;
         }
     }
@@ -225,7 +248,7 @@ bool MyBattleStatus::isTargetOnSight(Direction::DirectionType dir, Position targ
  * @return false If the position is not safe
  */
 bool MyBattleStatus::isSafePosition(Position p, const bool immediate_safe) const {
-    if (board[p.x][p.y] != boardItemToChar(BoardItem::EMPTY)) {
+    if (getBoardItem(p) != boardItemToChar(BoardItem::EMPTY)) {
         return false;
     }
 
@@ -301,6 +324,7 @@ ActionRequest MyBattleStatus::rotateTowards(Direction::DirectionType to_directio
  * - The positions of all allied tanks
  * - The positions of all enemy tanks
  * - The positions of all shells
+ * - The walls and allies that block line of sight
  * 
  * This information is stored for quick access when making decisions.
  */
@@ -308,24 +332,36 @@ void MyBattleStatus::updateTanksPosition() {
     std::vector<Position> enemy;
     std::vector<Position> ally;
     std::vector<Position> shells;
-    for (size_t i{0}; i < board.size(); i++) {
-        for (size_t j{0}; j < board.front().size(); j++) {
+    if (board == nullptr) return;
+    line_of_sight.reset(board_x, board_y);
+
+    for (size_t j{0}; j < board_y; j++) {
+        const char *row = board->row(j);
+        for (size_t i{0}; i < board_x; i++) {
             Position pos = {i, j};
+            const char item = (i == self_x && j == self_y) ? boardItemToChar(BoardItem::CURRENT_TANK) : row[i];
 
-            if (board[i][j] == getAllyName()) {
+            if (item == getAllyName()) {
                 ally.push_back(pos);
-            } else if (board[i][j] == boardItemToChar(BoardItem::CURRENT_TANK)) {
+                line_of_sight.addBlocker(pos);
+            } else if (item == boardItemToChar(BoardItem::WALL)) {
+                line_of_sight.addBlocker(pos);
+            } else if (item == boardItemToChar(BoardItem::CURRENT_TANK)) {
                 tank_position = pos;
-            } else if (board[i][j] == getEnemyName()) {
+            } else if (item == getEnemyName()) {
                 enemy.push_back(pos);
-            } else if (board[i][j] == boardItemToChar(BoardItem::SHELL)) {
+            } else if (item == boardItemToChar(BoardItem::SHELL)) {
                 shells.push_back(pos);
             }
         }
     }
-    ally_positions = ally;
-    enemy_positions = enemy;
-    shells_position = shells;
+    // Keep the column-major order callers always got
+    std::sort(ally.begin(), ally.end());
+    std::sort(enemy.begin(), enemy.end());
+    std::sort(shells.begin(), shells.end());
+    ally_positions = std::move(ally);
+    enemy_positions = std::move(enemy);
+    shells_position = std::move(shells);
 }
 
 /**
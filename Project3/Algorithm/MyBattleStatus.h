@@ -1,7 +1,10 @@
 #ifndef BATTLEUTILS_H
 #define BATTLEUTILS_H
+#include <memory>
 #include <vector>
 #include "Direction.h"
+#include "LineOfSight.h"
+#include "../UserCommon/SatelliteSnapshot.h"
 
 /**
  * @class MyBattleStatus
@@ -45,7 +48,8 @@ public:
 
     explicit MyBattleStatus(int player_id, int tank_index);
 
-    void updateBoard(const std::vector<std::vector<char> > &updated_board);
+    void updateBoard(std::shared_ptr<const UserCommon_123456789_987654321::BoardSnapshot> updated_board,
+                     size_t self_x, size_t self_y);
 
     Position updatePosition(Position p) const;
 
@@ -116,10 +120,13 @@ public:
     }
 
 private:
-    std::vector<std::vector<char> > board = {};  ///< 2D representation of the current game board
+    std::shared_ptr<const UserCommon_123456789_987654321::BoardSnapshot> board; ///< Last board snapshot received
+    size_t self_x{0};    ///< Column of this tank's own cell, reported as CURRENT_TANK (out of range if none)
+    size_t self_y{0};    ///< Row of this tank's own cell
     std::vector<Position> enemy_positions = {};  ///< Cached positions of all enemy tanks
     std::vector<Position> ally_positions = {};   ///< Cached positions of all allied tanks
     std::vector<Position> shells_position = {};  ///< Cached positions of all shells on the board
+    LineOfSight line_of_sight;                   ///< Walls and allies blocking this tank's shots
 
     int player_id{0};    ///< ID of the player (1 or 2)
     int tank_index{0};   ///< Index of this tank for the player
@@ -13,15 +13,19 @@ MyTankAlgorithm::MyTankAlgorithm(const int player_id, const int tank_index): pla
 
 void MyTankAlgorithm::updateBattleInfo(BattleInfo &info) {
     if (const MyBattleInfo *my_battle_info = dynamic_cast<MyBattleInfo *>(&info)) {
-        battle_status.updateBoard(my_battle_info->getBoard());
+        battle_status.updateBoard(my_battle_info->getBoard(), my_battle_info->getSelfX(), my_battle_info->getSelfY());
+        attack_field = my_battle_info->getAttackField();
+        if (attack_field == nullptr) {
+            attack_field = std::make_shared<AttackField>(my_battle_info->getBoard(), player_id);
+        }
         battle_status.shells_count = my_battle_info->getNumShells();
         battle_status.max_steps = my_battle_info->getMaxSteps();
     }
 }
 
 void MyTankAlgorithm::printLogs(const std::string &msg) const {
-    Logger::getInstance().log("Player " + std::to_string(player_id) + " - Tank Index " +
-                              std::to_string(tank_index) + " " + msg);
+    LOG_DEBUG(Logger::current(), "Player " + std::to_string(player_id) + " - Tank Index " +
+                                 std::to_string(tank_index) + " " + msg);
 }
 
 ActionRequest MyTankAlgorithm::getAction() {
@@ -1,8 +1,10 @@
 #ifndef ALGORITHM_H
 #define ALGORITHM_H
 
+#include <memory>
 #include <string>
 
+#include "AttackField.h"
 #include "MyBattleStatus.h"
 #include "TankAlgorithm.h"
 
@@ -16,6 +18,7 @@ protected:
     int player_id{0};
     int tank_index = {0};
     MyBattleStatus battle_status;
+    std::shared_ptr<const AttackField> attack_field; ///< Player-wide field of the current board snapshot
 
     MyTankAlgorithm(int player_id, int tank_index);
 
@@ -0,0 +1,68 @@
+#include "AlgorithmBudget.h"
+
+#include <algorithm>
+#include <sstream>
+
+void AlgorithmBudget::setTanks(const std::vector<std::pair<int, int> > &tank_ids) {
+    tanks.assign(tank_ids.size(), TankRecord{});
+    for (size_t i = 0; i < tank_ids.size(); i++) {
+        tanks[i].player_index = tank_ids[i].first;
+        tanks[i].tank_index = tank_ids[i].second;
+    }
+}
+
+bool AlgorithmBudget::record(const size_t tank, const Duration elapsed, const size_t step) {
+    TankRecord &record = tanks[tank];
+    record.latency.add(static_cast<uint64_t>(std::max<Duration::rep>(0, elapsed.count())));
+    record.total += elapsed;
+
+    bool within = true;
+    if (call_limit.count() > 0 && elapsed > call_limit) {
+        record.overruns++;
+        within = false;
+    }
+    if (game_limit.count() > 0 && record.total > game_limit && !record.timed_out) {
+        record.timed_out = true;
+        record.timed_out_step = step;
+        within = false;
+    }
+    return within;
+}
+
+AlgorithmBudget::TankLatency AlgorithmBudget::getLatency(const size_t tank) const {
+    const TankRecord &record = tanks[tank];
+    TankLatency latency;
+    latency.calls = record.latency.count;
+    latency.total = record.total;
+    latency.p50 = Duration(record.latency.percentile(0.5));
+    latency.p99 = Duration(record.latency.percentile(0.99));
+    latency.max = Duration(record.latency.max);
+    latency.overruns = record.overruns;
+    latency.timed_out = record.timed_out;
+    latency.timed_out_step = record.timed_out_step;
+    return latency;
+}
+
+std::string AlgorithmBudget::formatTimeouts() const {
+    std::string text;
+    for (const TankRecord &record: tanks) {
+        if (!record.timed_out) continue;
+        text += text.empty() ? "Timed out: " : ", ";
+        text += "tank " + std::to_string(record.player_index) + "." + std::to_string(record.tank_index) +
+                " at step " + std::to_string(record.timed_out_step);
+    }
+    return text;
+}
+
+std::string AlgorithmBudget::formatLatency() const {
+    std::ostringstream out;
+    for (size_t i = 0; i < tanks.size(); i++) {
+        const TankLatency latency = getLatency(i);
+        out << "Tank " << tanks[i].player_index << "." << tanks[i].tank_index << " algorithm: calls "
+            << latency.calls << ", p50 " << latency.p50.count() << " ns, p99 " << latency.p99.count()
+            << " ns, max " << latency.max.count() << " ns, overruns " << latency.overruns;
+        if (latency.timed_out) out << ", timed out at step " << latency.timed_out_step;
+        out << "\n";
+    }
+    return out.str();
+}
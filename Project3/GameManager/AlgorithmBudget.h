@@ -0,0 +1,87 @@
+#ifndef ALGORITHM_BUDGET_H
+#define ALGORITHM_BUDGET_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "StepProfile.h"
+
+/**
+ * Time limits on the tank algorithms of one game, and the latency of their calls.
+ *
+ * Algorithm calls are synchronous and can't be cut short, so the budget is
+ * enforced on what a call produces: an action from a call that took longer
+ * than the per-call limit is replaced by DoNothing, and a tank whose calls
+ * have used up the per-game limit is timed out. A timed out tank is not asked
+ * for actions again and does nothing for the rest of the game, so one slow
+ * algorithm can stall a game for at most about one per-game budget.
+ *
+ * Every call is measured whether or not limits are set, into a fixed size
+ * histogram per tank, so p50 and p99 are the upper bounds of power of two
+ * buckets, like in StepProfile.
+ */
+class AlgorithmBudget {
+public:
+    using Duration = std::chrono::nanoseconds;
+
+    struct TankLatency {
+        size_t calls = 0;
+        Duration total{0};
+        Duration p50{0};
+        Duration p99{0};
+        Duration max{0};
+        size_t overruns = 0;     ///< Calls longer than the per-call limit
+        bool timed_out = false;
+        size_t timed_out_step = 0;
+    };
+
+    /**
+     * @brief Sets the limits; a zero limit is no limit
+     *
+     * @param per_call Longest a single getAction or updateTankWithBattleInfo call may take
+     * @param per_game Time all the calls of one tank's algorithm may take over the game
+     */
+    void setLimits(const Duration per_call, const Duration per_game) {
+        call_limit = per_call;
+        game_limit = per_game;
+    }
+
+    // One entry per tank algorithm: (player index, tank index), in tank algorithm order
+    void setTanks(const std::vector<std::pair<int, int> > &tank_ids);
+
+    [[nodiscard]] bool isTimedOut(const size_t tank) const { return tanks[tank].timed_out; }
+
+    /**
+     * @brief Records one call of a tank's algorithm
+     * @return false if the call broke the budget, in which case its action must not be used
+     */
+    bool record(size_t tank, Duration elapsed, size_t step);
+
+    [[nodiscard]] TankLatency getLatency(size_t tank) const;
+
+    // "Timed out: tank 1.0 at step 12, ..." for the result, or empty if no tank timed out
+    [[nodiscard]] std::string formatTimeouts() const;
+
+    // One line per tank with its calls, p50, p99, max and overruns
+    [[nodiscard]] std::string formatLatency() const;
+
+private:
+    struct TankRecord {
+        int player_index = 0;
+        int tank_index = 0;
+        StepProfile::Histogram latency; ///< Nanoseconds per call
+        Duration total{0};
+        size_t overruns = 0;
+        bool timed_out = false;
+        size_t timed_out_step = 0;
+    };
+
+    Duration call_limit{0};
+    Duration game_limit{0};
+    std::vector<TankRecord> tanks;
+};
+
+#endif //ALGORITHM_BUDGET_H
@@ -10,77 +10,183 @@
 #include "WeakWall.h"
 #include "Shell.h"
 
+void Board::initGrid() {
+    const size_t cells = width * height;
+    cell_kind.assign(cells, CellKind::EMPTY);
+    wall_health.assign(cells, 0);
+    cell_entity.assign(cells, NO_ENTITY);
+    cell_dirty.assign(cells, false);
+    dirty_cells.clear();
+
+    wrap_x.resize(width * 3);
+    for (size_t i = 0; i < wrap_x.size(); i++) wrap_x[i] = static_cast<int>(i % width);
+    wrap_y.resize(height * 3);
+    for (size_t i = 0; i < wrap_y.size(); i++) wrap_y[i] = static_cast<int>(i % height);
+}
+
+size_t Board::cellIndex(const Position real_pos) const {
+    const auto [x, y] = updatePositionReal(real_pos);
+    return y * width + x;
+}
+
+GameObject *Board::cellObject(const size_t cell) const {
+    const uint32_t entity = cell_entity[cell];
+    return entity == NO_ENTITY ? nullptr : entities[entity].get();
+}
+
+void Board::setCell(const size_t cell, std::unique_ptr<GameObject> element, const bool track_change) {
+    if (element == nullptr) return;
+
+    CellKind kind = CellKind::EMPTY;
+    switch (element->getKind()) {
+        case ObjectKind::WALL:
+            kind = CellKind::WALL;
+            wall_health[cell] = static_cast<uint8_t>(static_cast<Wall *>(element.get())->getHealth());
+            break;
+        case ObjectKind::MINE: kind = CellKind::MINE; break;
+        case ObjectKind::TANK:
+            kind = static_cast<Tank *>(element.get())->getPlayerIndex() == 1 ? CellKind::TANK_1 : CellKind::TANK_2;
+            break;
+        case ObjectKind::SHELL: kind = CellKind::SHELL; break;
+        case ObjectKind::COLLISION: kind = CellKind::COLLISION; break;
+    }
+    cell_kind[cell] = kind;
+    if (track_change) markDirty(cell);
+
+    uint32_t entity;
+    if (!free_entities.empty()) {
+        entity = free_entities.back();
+        free_entities.pop_back();
+        entities[entity] = std::move(element);
+    } else {
+        entity = static_cast<uint32_t>(entities.size());
+        entities.push_back(std::move(element));
+    }
+    cell_entity[cell] = entity;
+}
+
+std::unique_ptr<GameObject> Board::takeCell(const size_t cell) {
+    const uint32_t entity = cell_entity[cell];
+    if (entity == NO_ENTITY) return nullptr;
+
+    cell_kind[cell] = CellKind::EMPTY;
+    cell_entity[cell] = NO_ENTITY;
+    markDirty(cell);
+    free_entities.push_back(entity);
+    return std::move(entities[entity]);
+}
+
+void Board::markDirty(const size_t cell) {
+    // Objects halfway between cells are not visible to the satellite
+    if (cell_dirty[cell] || (cell % width) % 2 != 0 || (cell / width) % 2 != 0) return;
+    cell_dirty[cell] = true;
+    dirty_cells.push_back(static_cast<uint32_t>(cell));
+}
+
+char Board::cellSymbol(const size_t cell) const {
+    static constexpr char symbols[] = {' ', '#', '@', '1', '2', '*', '*'};
+    const CellKind kind = cell_kind[cell];
+    if (kind == CellKind::WALL && wall_health[cell] == 1) return '=';
+    return symbols[static_cast<uint8_t>(kind)];
+}
+
 GameObject *Board::placeObjectReal(std::unique_ptr<GameObject> element, const Position real_pos) {
     const auto [x, y] = updatePositionReal(real_pos);
+    const size_t cell = y * width + x;
+    if (element->getId() == GameObject::NO_ID) element->assignId(next_object_id++);
 
-    if (const auto tank = dynamic_cast<Tank *>(element.get())) {
-        tanks_pos[{tank->getPlayerIndex(), tank->getTankIndex()}] = Position(x, y);
+    if (const auto tank = objectCast<Tank>(element.get())) {
+        tanks_pos[tank->getPlayerIndex()].insert(tank->getTankIndex(), Position(x, y));
     }
 
-    if (const auto shell = dynamic_cast<Shell *>(element.get())) {
-        shells_pos[shell->getId()] = Position(x, y);
+    if (const auto shell = objectCast<Shell>(element.get())) {
+        shells_pos.insert(shell->getId(), Position(x, y));
     }
 
     // Check for collision
-    if (isOccupiedReal(real_pos)) {
-        if (const auto collision = dynamic_cast<Collision *>(getObjectReal(real_pos))) {
+    if (GameObject *occupant = cellObject(cell)) {
+        if (const auto collision = objectCast<Collision>(occupant)) {
             collision->addElement(std::move(element));
         } else {
-            board[y][x] = std::make_unique<Collision>(std::move(board[y][x]), std::move(element));
-            collisions_pos[board[y][x]->getId()] = Position(x, y);
+            auto new_collision = std::make_unique<Collision>(takeCell(cell), std::move(element));
+            new_collision->assignId(next_object_id++);
+            collisions_pos.insert(new_collision->getId(), Position(x, y));
+            setCell(cell, std::move(new_collision));
         }
     } else {
-        board[y][x] = std::move(element);
+        setCell(cell, std::move(element));
     }
 
-    GameObject *game_object = board[y][x].get();
+    GameObject *game_object = cellObject(cell);
 
     if (x % 2 == 0 && y % 2 == 0) {
         game_object->setPosition(Position(x / 2, y / 2));
     } else {
-        moving_pos[game_object->getId()] = Position(x, y);
+        moving_pos.insert(game_object->getId(), Position(x, y));
     }
 
     return game_object;
 }
 
+/**
+ * Places an object read from the map on its whole cell while the board is being
+ * loaded. Nothing can collide yet, and no snapshot has been taken (the first one
+ * is always filled from scratch), so neither is checked for.
+ */
+GameObject *Board::placeMapObject(std::unique_ptr<GameObject> element) {
+    const Position real_pos = updatePositionReal(element->getPosition() * 2);
+    const size_t cell = real_pos.y * width + real_pos.x;
+    if (cell_entity[cell] != NO_ENTITY) return placeObjectReal(std::move(element), real_pos);
+
+    if (element->getId() == GameObject::NO_ID) element->assignId(next_object_id++);
+    if (const auto tank = objectCast<Tank>(element.get())) {
+        tanks_pos[tank->getPlayerIndex()].insert(tank->getTankIndex(), real_pos);
+    }
+    element->setPosition(real_pos / 2);
+    setCell(cell, std::move(element), false);
+    return cellObject(cell);
+}
+
 Position Board::updatePositionReal(const Position real_pos) const {
-    const size_t mod_x = (real_pos.x % width + width) % width;
-    const size_t mod_y = (real_pos.y % height + height) % height;
-    return {mod_x, mod_y};
+    const int w = static_cast<int>(width);
+    const int h = static_cast<int>(height);
+    // Objects never stray more than one board length off the grid, so the tables cover every real lookup
+    const int x = real_pos.x >= -w && real_pos.x < 2 * w ? wrap_x[real_pos.x + w] : (real_pos.x % w + w) % w;
+    const int y = real_pos.y >= -h && real_pos.y < 2 * h ? wrap_y[real_pos.y + h] : (real_pos.y % h + h) % h;
+    return {x, y};
 }
 
 GameObject *Board::getObjectReal(const Position real_pos) const {
-    const auto [x, y] = updatePositionReal(real_pos);
-    return board[y][x].get();
+    return cellObject(cellIndex(real_pos));
 }
 
 bool Board::isOccupiedReal(const Position real_pos) const {
-    return getObjectReal(real_pos) != nullptr;
+    return cell_entity[cellIndex(real_pos)] != NO_ENTITY;
 }
 
 void Board::removeObjectReal(const Position real_pos) {
-    const auto [x, y] = updatePositionReal(real_pos);
-    if (board[y][x] != nullptr) removeIndices(board[y][x].get());
-    destroyed.push_back(std::move(board[y][x]));
+    const size_t cell = cellIndex(real_pos);
+    if (GameObject *game_object = cellObject(cell)) removeIndices(game_object);
+    discard(takeCell(cell));
 }
 
 GameObject *Board::replaceObjectReal(const Position from_real, const Position to_real) {
-    const auto [f_x, f_y] = updatePositionReal(from_real);
-    if (!isOccupiedReal(from_real)) return nullptr;
+    const size_t from_cell = cellIndex(from_real);
+    if (cellObject(from_cell) == nullptr) return nullptr;
 
     std::unique_ptr<GameObject> element = nullptr;
 
     // Handle moving collisions -> If not ok, move entire collision. Else, move just the shell.
-    if (const auto collision = dynamic_cast<Collision *>(getObjectReal(from_real))) {
+    if (const auto collision = objectCast<Collision>(cellObject(from_cell))) {
         if (collision->validateCollision()) {
             element = collision->getShell();
             std::unique_ptr<Mine> mine = collision->getMine();
             removeIndices(collision);
-            board[f_y][f_x] = std::move(mine);
+            takeCell(from_cell);
+            setCell(from_cell, std::move(mine));
         }
     }
-    if (element == nullptr) element = std::move(board[f_y][f_x]);
+    if (element == nullptr) element = takeCell(from_cell);
 
     removeIndices(element.get());
     return placeObjectReal(std::move(element), to_real);
@@ -93,18 +199,18 @@ GameObject *Board::moveObjectReal(const Position from_real, const Direction::Dir
 void Board::removeIndices(GameObject *game_object) {
     if (game_object == nullptr) return;
 
-    if (const auto tank = dynamic_cast<Tank *>(game_object)) {
-        tanks_pos.erase({tank->getPlayerIndex(), tank->getTankIndex()});
+    if (const auto tank = objectCast<Tank>(game_object)) {
+        tanks_pos[tank->getPlayerIndex()].erase(tank->getTankIndex());
     }
 
-    if (const auto shell = dynamic_cast<Shell *>(game_object)) {
+    if (const auto shell = objectCast<Shell>(game_object)) {
         shells_pos.erase(shell->getId());
     }
 
-    if (const auto collision = dynamic_cast<Collision *>(game_object)) {
+    if (const auto collision = objectCast<Collision>(game_object)) {
         while (auto it = collision->popElement()) {
             removeIndices(it.get());
-            destroyed.push_back(std::move(it));
+            discard(std::move(it));
         }
         collisions_pos.erase(collision->getId());
     }
@@ -112,19 +218,19 @@ void Board::removeIndices(GameObject *game_object) {
     moving_pos.erase(game_object->getId());
 }
 
+void Board::discard(std::unique_ptr<GameObject> game_object) {
+    // Everything else goes straight back to its allocator
+    if (game_object != nullptr && game_object->isTank()) destroyed_tanks.push_back(std::move(game_object));
+}
+
 Board::Board(): max_steps(0), shells_count(0) {
+    initGrid();
 }
 
 Board::Board(std::string desc, const size_t max_steps, const size_t shells_count, size_t width,
              size_t height) : desc(std::move(desc)), max_steps(max_steps), shells_count((shells_count)), width(width * 2),
-                              height(height * 2),
-                              board(std::vector<std::vector<std::unique_ptr<GameObject> > >(
-                                  height * 2)) {
-    for (size_t i = 0; i < this->height; i++) {
-        for (size_t j = 0; j < this->width; j++) {
-            board[i].push_back(nullptr);
-        }
-    }
+                              height(height * 2) {
+    initGrid();
 }
 
 bool Board::isOccupied(const Position pos) const {
@@ -145,11 +251,12 @@ GameObject *Board::getObject(const Position pos) const {
 
 std::vector<Tank *> Board::getAliveTanks() const {
     std::vector<Tank *> tanks;
-    for (auto pos: tanks_pos) {
-        GameObject *b = getObjectReal(pos.second);
-        if (auto t = dynamic_cast<Tank *>(b)) {
-            if (!t->isDestroyed()) tanks.push_back(t);
-        }
+    for (const auto &player_tanks: tanks_pos) {
+        player_tanks.forEach([this, &tanks](int, const Position pos) {
+            if (auto t = objectCast<Tank>(getObjectReal(pos))) {
+                if (!t->isDestroyed()) tanks.push_back(t);
+            }
+        });
     }
     return tanks;
 }
@@ -157,17 +264,16 @@ std::vector<Tank *> Board::getAliveTanks() const {
 std::vector<Tank *> Board::getTanks() const {
     std::vector<Tank *> tanks;
 
-    for (auto pos: tanks_pos) {
-        GameObject *b = getObjectReal(pos.second);
-        if (auto t = dynamic_cast<Tank *>(b)) {
-            tanks.push_back(t);
-        }
+    for (const auto &player_tanks: tanks_pos) {
+        player_tanks.forEach([this, &tanks](int, const Position pos) {
+            if (auto t = objectCast<Tank>(getObjectReal(pos))) {
+                tanks.push_back(t);
+            }
+        });
     }
 
-    for (auto &obj: destroyed) {
-        if (auto t = dynamic_cast<Tank *>(obj.get())) {
-            tanks.push_back(t);
-        }
+    for (auto &obj: destroyed_tanks) {
+        tanks.push_back(static_cast<Tank *>(obj.get()));
     }
 
     return tanks;
@@ -206,61 +312,258 @@ Tank *Board::getPlayerTank(int player_index, int tank_index) const {
 }
 
 void Board::checkCollisions() {
-    auto tmp_pos = collisions_pos;
-    for (const auto [id, pos] : tmp_pos) {
-        if (const auto collision = dynamic_cast<Collision *>(getObjectReal(pos))) {
-            if (collision->validateCollision()) continue;
+    collisions_pos.forEach([this](int, const Position pos) {
+        if (const auto collision = objectCast<Collision>(getObjectReal(pos))) {
+            if (collision->validateCollision()) return;
 
             if (std::unique_ptr<Wall> wall = collision->getWeakenedWall()) {
                 removeObjectReal(pos);
                 placeObjectReal(std::move(wall), pos);
-                continue;
+                return;
             }
         }
 
         removeObjectReal(pos);
-    }
+    });
 }
 
-void Board::fillSatelliteView(MySatelliteView &satellite_view) const {
-    for (size_t i = 0; i < width; i++) {
-        for (size_t j = 0; j < height; j++) {
-            if (isCollision({i, j}))
-                satellite_view.setObject(i, j, '*'); 
-            else if (isOccupied({i, j}))
-                satellite_view.setObject(i, j, getObject({i, j})->getSymbol());
-            else
-                satellite_view.setObject(i, j, ' ');
+void Board::fillSnapshot(UserCommon_123456789_987654321::BoardSnapshot &snapshot) const {
+    // Whole cells sit on the even rows and columns of the real grid
+    for (size_t y = 0; y < height; y += 2) {
+        const size_t row = y * width;
+        char *out = snapshot.row(y / 2);
+        for (size_t x = 0; x < width; x += 2) {
+            out[x / 2] = cellSymbol(row + x);
         }
     }
 }
 
+void Board::applyChanges(UserCommon_123456789_987654321::BoardSnapshot &snapshot) {
+    writeCells(snapshot, dirty_cells);
+    clearChanges();
+}
+
+void Board::writeCells(UserCommon_123456789_987654321::BoardSnapshot &snapshot,
+                       const std::vector<uint32_t> &cells) const {
+    for (const uint32_t cell: cells) {
+        snapshot.set((cell % width) / 2, (cell / width) / 2, cellSymbol(cell));
+    }
+}
+
+void Board::clearChanges() {
+    for (const uint32_t cell: dirty_cells) cell_dirty[cell] = false;
+    dirty_cells.clear();
+}
+
 void Board::finishMove() {
     checkCollisions();
 
-    const auto tmp_pos = moving_pos;
-    for (const auto [id, pos] : tmp_pos) {
+    moving_pos.forEach([this](const int id, const Position pos) {
         if (const auto obj = getObjectReal(pos)) {
             moveObjectReal(pos, obj->getDirection());
         } else {
             moving_pos.erase(id);
         }
-    }
+    });
 
     checkCollisions();
 }
 
-std::map<int, Shell *> Board::getShells() const {
-    std::map<int, Shell *> shells;
-    for (const auto [id, pos]: shells_pos) {
-        if (const auto shell = dynamic_cast<Shell *>(getObjectReal(pos))) {
-            shells[id] = shell;
+std::vector<std::pair<int, Shell *> > Board::getShells() const {
+    std::vector<std::pair<int, Shell *> > shells;
+    shells.reserve(shells_pos.size());
+    shells_pos.forEach([this, &shells](const int id, const Position pos) {
+        if (const auto shell = objectCast<Shell>(getObjectReal(pos))) {
+            shells.emplace_back(id, shell);
         }
-        if (const auto collision = dynamic_cast<Collision *>(getObjectReal(pos))) {
+        if (const auto collision = objectCast<Collision>(getObjectReal(pos))) {
             if (collision->validateCollision()) {
-                shells[id] = collision->getShellPtr();
+                shells.emplace_back(id, collision->getShellPtr());
             }
         }
-    }
+    });
     return shells;
 }
+
+std::vector<uint8_t> Board::getMapLayout() const {
+    std::vector<uint8_t> layout;
+    layout.reserve(width * height / 4);
+    for (size_t y = 0; y < height; y += 2) {
+        for (size_t x = 0; x < width; x += 2) {
+            const size_t cell = y * width + x;
+            switch (cell_kind[cell]) {
+                case CellKind::WALL:
+                    layout.push_back(static_cast<uint8_t>(BoardState::WALL_CELL + wall_health[cell] - 1));
+                    break;
+                // Between steps a collision can only be a shell flying over a mine
+                case CellKind::MINE:
+                case CellKind::COLLISION:
+                    layout.push_back(BoardState::MINE_CELL);
+                    break;
+                default:
+                    layout.push_back(BoardState::EMPTY_CELL);
+            }
+        }
+    }
+    return layout;
+}
+
+BoardState Board::captureState(const std::vector<uint8_t> &map_layout) const {
+    BoardState state;
+    state.next_object_id = next_object_id;
+
+    const std::vector<uint8_t> layout = getMapLayout();
+    const size_t row_cells = width / 2;
+    for (size_t i = 0; i < layout.size() && i < map_layout.size(); i++) {
+        if (layout[i] == map_layout[i]) continue;
+        const Position pos(static_cast<int>(i % row_cells), static_cast<int>(i / row_cells));
+        if (layout[i] == BoardState::EMPTY_CELL) state.cleared.push_back(pos);
+        else state.weakened.push_back(pos);
+    }
+
+    auto save_tank = [&state](const Tank &tank, const Position pos, const bool destroyed) {
+        state.tanks.push_back({
+            tank.getId(), pos, tank.getPlayerIndex(), tank.getTankIndex(), tank.getTankAlgoIndex(),
+            tank.getDirection(), tank.getAmmunition(), tank.getCooldown(), tank.getBackwardsCounter(), destroyed
+        });
+    };
+    for (const auto &player_tanks: tanks_pos) {
+        player_tanks.forEach([this, &save_tank](int, const Position pos) {
+            if (const auto tank = objectCast<Tank>(getObjectReal(pos))) save_tank(*tank, pos / 2, false);
+        });
+    }
+    for (const auto &obj: destroyed_tanks) {
+        const auto tank = static_cast<const Tank *>(obj.get());
+        save_tank(*tank, tank->getPosition(), true);
+    }
+
+    shells_pos.forEach([this, &state](const int id, const Position pos) {
+        GameObject *occupant = getObjectReal(pos);
+        int collision_id = -1;
+        const Shell *shell = objectCast<Shell>(occupant);
+        if (const auto collision = objectCast<Collision>(occupant)) {
+            collision_id = collision->getId();
+            shell = collision->getShellPtr();
+        }
+        if (shell == nullptr) return;
+        state.shells.push_back({id, pos / 2, shell->getDirection(), shell->getOwnerId(), collision_id});
+    });
+    return state;
+}
+
+void Board::restoreState(const BoardState &state) {
+    for (const Position pos: state.cleared) {
+        removeObjectReal(pos * 2);
+    }
+    for (const Position pos: state.weakened) {
+        const size_t cell = cellIndex(pos * 2);
+        std::unique_ptr<GameObject> wall = takeCell(cell);
+        if (wall == nullptr) continue;
+        wall->takeDamage();
+        setCell(cell, std::move(wall));
+    }
+
+    // The tanks of the map are replaced by the captured ones
+    for (auto &player_tanks: tanks_pos) {
+        player_tanks.forEach([this](int, const Position pos) { removeObjectReal(pos); });
+    }
+    destroyed_tanks.clear();
+
+    for (const auto &saved: state.tanks) {
+        auto tank = std::make_unique<Tank>(saved.position, saved.player_index, saved.tank_index,
+                                           saved.tank_algo_index, static_cast<size_t>(saved.ammunition));
+        tank->assignId(saved.id);
+        tank->setDirection(saved.direction);
+        tank->setCooldown(saved.cooldown);
+        tank->setBackwardsCounter(saved.backwards_counter);
+        if (saved.destroyed) {
+            tank->destroy();
+            destroyed_tanks.push_back(std::move(tank));
+        } else {
+            placeObjectReal(std::move(tank), saved.position * 2);
+        }
+    }
+
+    for (const auto &saved: state.shells) {
+        auto shell = std::make_unique<Shell>(saved.position, saved.direction, saved.owner_id);
+        shell->assignId(saved.id);
+        if (saved.collision_id == -1) {
+            placeObjectReal(std::move(shell), saved.position * 2);
+            continue;
+        }
+
+        // Rebuild the settled collision with the mine of the map under it, keeping its id
+        const Position real_pos = updatePositionReal(saved.position * 2);
+        const size_t cell = cellIndex(real_pos);
+        shells_pos.insert(saved.id, real_pos);
+        auto collision = std::make_unique<Collision>(takeCell(cell), std::move(shell));
+        collision->assignId(saved.collision_id);
+        collision->validateCollision();
+        collisions_pos.insert(saved.collision_id, real_pos);
+        setCell(cell, std::move(collision));
+    }
+
+    next_object_id = state.next_object_id;
+}
+
+namespace {
+// A new wall, mine or tank in the same state as object; other objects are not copied
+std::unique_ptr<GameObject> cloneMapObject(const GameObject &object) {
+    std::unique_ptr<GameObject> copy;
+    if (const auto tank = objectCast<Tank>(&object)) {
+        auto tank_copy = std::make_unique<Tank>(tank->getPosition(), tank->getPlayerIndex(), tank->getTankIndex(),
+                                                tank->getTankAlgoIndex(),
+                                                static_cast<size_t>(tank->getAmmunition()));
+        tank_copy->setCooldown(tank->getCooldown());
+        tank_copy->setBackwardsCounter(tank->getBackwardsCounter());
+        copy = std::move(tank_copy);
+    } else if (const auto wall = objectCast<Wall>(&object)) {
+        if (wall->getHitPoints() == 1) copy = std::make_unique<WeakWall>(wall->getPosition());
+        else copy = std::make_unique<Wall>(wall->getPosition());
+        for (int hits = wall->getHitPoints() - wall->getHealth(); hits > 0; hits--) copy->takeDamage();
+    } else if (objectCast<Mine>(&object) != nullptr) {
+        copy = std::make_unique<Mine>(object.getPosition());
+    } else {
+        return nullptr;
+    }
+    copy->setDirection(object.getDirection());
+    copy->assignId(object.getId());
+    return copy;
+}
+}
+
+/**
+ * @brief Copies a board that was just read, so a map parsed once can start many games
+ *
+ * The grid and the position indices are copied in bulk; only the objects are built
+ * again, with the same ids. The board must hold nothing but walls, mines and tanks
+ * (no shells, collisions or destroyed tanks), which is always the case before the
+ * first step.
+ */
+std::unique_ptr<Board> Board::cloneMap() const {
+    auto copy = std::make_unique<Board>();
+    copy->desc = desc;
+    copy->max_steps = max_steps;
+    copy->shells_count = shells_count;
+    copy->width = width;
+    copy->height = height;
+    copy->cell_kind = cell_kind;
+    copy->wall_health = wall_health;
+    copy->cell_entity = cell_entity;
+    copy->wrap_x = wrap_x;
+    copy->wrap_y = wrap_y;
+    copy->free_entities = free_entities;
+    copy->next_object_id = next_object_id;
+    copy->dirty_cells = dirty_cells;
+    copy->cell_dirty = cell_dirty;
+    copy->tanks_pos = tanks_pos;
+    copy->shells_pos = shells_pos;
+    copy->collisions_pos = collisions_pos;
+    copy->moving_pos = moving_pos;
+
+    copy->entities.resize(entities.size());
+    for (size_t i = 0; i < entities.size(); i++) {
+        if (entities[i] != nullptr) copy->entities[i] = cloneMapObject(*entities[i]);
+    }
+    return copy;
+}
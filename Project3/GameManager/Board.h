@@ -1,17 +1,21 @@
 #ifndef BOARD_H
 #define BOARD_H
 
+#include <cstdint>
+#include <array>
 #include <iostream>
-#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
+#include "BoardState.h"
 #include "GameObject.h"
 #include "Mine.h"
-#include "MySatelliteView.h"
+#include "PositionIndex.h"
 #include "Shell.h"
 #include "Tank.h"
 #include "Wall.h"
+#include "../UserCommon/SatelliteSnapshot.h"
 
 enum ObjectType {
     TANK_1,
@@ -20,18 +24,65 @@ enum ObjectType {
     WALL,
 };
 
+// What occupies a board cell, one byte per cell
+enum class CellKind : uint8_t {
+    EMPTY,
+    WALL,
+    MINE,
+    TANK_1,
+    TANK_2,
+    SHELL,
+    COLLISION,
+};
+
 class Board {
     std::string desc;
     size_t max_steps;
     size_t shells_count;
+    static constexpr uint32_t NO_ENTITY = UINT32_MAX;
+
     size_t width = 2;
     size_t height = 2;
-    std::vector<std::vector<std::unique_ptr<GameObject> > > board;
-    std::map<std::pair<int, int>, Position> tanks_pos;
-    std::map<int, Position> shells_pos;
-    std::map<int, Position> collisions_pos;
-    std::map<int, Position> moving_pos;
-    std::vector<std::unique_ptr<GameObject> > destroyed;
+
+    // Doubled-resolution grid, row-major, one entry per real cell in each array
+    std::vector<CellKind> cell_kind;
+    std::vector<uint8_t> wall_health;
+    std::vector<uint32_t> cell_entity;
+    // wrap_x[x + width] is x wrapped onto the board, for x in [-width, 2 * width)
+    std::vector<int> wrap_x;
+    std::vector<int> wrap_y;
+
+    // Owner of every object on the grid, indexed by cell_entity
+    std::vector<std::unique_ptr<GameObject> > entities;
+    std::vector<uint32_t> free_entities;
+    // Next id handed to an object placed on this board for the first time
+    int next_object_id = 0;
+
+    // Whole cells whose symbol may have changed since the last applyChanges()
+    std::vector<uint32_t> dirty_cells;
+    std::vector<bool> cell_dirty;
+
+    // Real positions; tanks are indexed by tank index per player, the rest by object id
+    std::array<PositionIndex, MAX_PLAYERS> tanks_pos;
+    PositionIndex shells_pos;
+    PositionIndex collisions_pos;
+    PositionIndex moving_pos;
+    // Tanks removed from the board, kept so the game can still report them
+    std::vector<std::unique_ptr<GameObject> > destroyed_tanks;
+
+    void initGrid();
+
+    void markDirty(size_t cell);
+
+    char cellSymbol(size_t cell) const;
+
+    size_t cellIndex(Position real_pos) const;
+
+    GameObject *cellObject(size_t cell) const;
+
+    void setCell(size_t cell, std::unique_ptr<GameObject> element, bool track_change = true);
+
+    std::unique_ptr<GameObject> takeCell(size_t cell);
 
     GameObject *placeObjectReal(std::unique_ptr<GameObject> element, Position real_pos);
 
@@ -49,6 +100,8 @@ class Board {
 
     void removeIndices(GameObject *game_object);
 
+    void discard(std::unique_ptr<GameObject> game_object);
+
     void checkCollisions();
 
     void print_info() {
@@ -85,6 +138,11 @@ public:
 
     void removeObject(Position pos);
 
+    // Makes room for this many objects before a map is placed
+    void reserveObjects(size_t count) { entities.reserve(count); }
+
+    GameObject *placeMapObject(std::unique_ptr<GameObject> element);
+
     GameObject *replaceObject(Position from, Position to);
 
     GameObject *moveObject(Position from, Direction::DirectionType dir);
@@ -101,23 +159,53 @@ public:
 
     void finishMove();
 
-    std::map<int, Shell *> getShells() const;
+    std::vector<std::pair<int, Shell *> > getShells() const;
 
-    bool isWall(const Position pos) const { return isOccupied(pos) && getObject(pos)->isWall(); }
+    CellKind getCellKind(const Position pos) const { return cell_kind[cellIndex(pos * 2)]; }
 
-    bool isTank(const Position pos) const { return isOccupied(pos) && getObject(pos)->isTank(); }
+    bool isWall(const Position pos) const { return getCellKind(pos) == CellKind::WALL; }
 
-    bool isShell(const Position pos) const { return isOccupied(pos) && getObject(pos)->isShell(); }
+    bool isTank(const Position pos) const {
+        const CellKind kind = getCellKind(pos);
+        return kind == CellKind::TANK_1 || kind == CellKind::TANK_2;
+    }
+
+    bool isShell(const Position pos) const { return getCellKind(pos) == CellKind::SHELL; }
 
-    bool isCollision(const Position pos) const { return isOccupied(pos) && getObject(pos)->isCollision(); }
+    bool isCollision(const Position pos) const { return getCellKind(pos) == CellKind::COLLISION; }
 
-    bool isMine(const Position pos) const { return isOccupied(pos) && getObject(pos)->isMine(); }
+    bool isMine(const Position pos) const { return getCellKind(pos) == CellKind::MINE; }
 
     size_t getNumShells() const { return shells_count; }
 
     size_t getMaxSteps() const { return max_steps; }
 
-    void fillSatelliteView(MySatelliteView &satellite_view) const;
+    void fillSnapshot(UserCommon_123456789_987654321::BoardSnapshot &snapshot) const;
+
+    [[nodiscard]] bool hasChanges() const { return !dirty_cells.empty(); }
+
+    // Whole cells whose symbol may have changed since the last applyChanges() or clearChanges()
+    const std::vector<uint32_t> &getChanges() const { return dirty_cells; }
+
+    // Writes only the cells that changed since the last call into a snapshot that was up to date then
+    void applyChanges(UserCommon_123456789_987654321::BoardSnapshot &snapshot);
+
+    // Rewrites the given whole cells (as listed by getChanges()) of a snapshot from the board
+    void writeCells(UserCommon_123456789_987654321::BoardSnapshot &snapshot, const std::vector<uint32_t> &cells) const;
+
+    void clearChanges();
+
+    // Cell codes of the walls and mines currently on the board (see BoardState)
+    std::vector<uint8_t> getMapLayout() const;
+
+    // State between two steps, relative to the layout returned by getMapLayout() when the game started
+    BoardState captureState(const std::vector<uint8_t> &map_layout) const;
+
+    // Brings a board freshly parsed from the same map to a captured state
+    void restoreState(const BoardState &state);
+
+    // Copy of a board that holds only the objects of its map, as it does right after it is read
+    std::unique_ptr<Board> cloneMap() const;
 
     ~Board() = default;
 };
@@ -133,7 +221,12 @@ T *Board::placeObject(std::unique_ptr<T> element) {
     );
     if (element == nullptr) return nullptr;
     Position pos = element->getPosition();
-    return dynamic_cast<T *>(placeObjectReal(std::move(element), pos * 2));
+    GameObject *placed = placeObjectReal(std::move(element), pos * 2);
+    if constexpr (std::is_same_v<T, GameObject>) {
+        return placed;
+    } else {
+        return objectCast<T>(placed);
+    }
 }
 
 #endif //BOARD_H
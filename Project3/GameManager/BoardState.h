@@ -0,0 +1,51 @@
+#ifndef BOARD_STATE_H
+#define BOARD_STATE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Direction.h"
+
+/**
+ * State of a board between two steps, relative to the map it was parsed from.
+ *
+ * Walls and mines only ever disappear or weaken, so they are stored as the map
+ * cells that changed. Tanks and shells are stored in full, ids included, since
+ * the board orders its work by id.
+ */
+struct BoardState {
+    struct TankState {
+        int id;
+        Position position;
+        int player_index;
+        int tank_index;
+        int tank_algo_index;
+        Direction::DirectionType direction;
+        int ammunition;
+        int cooldown;
+        int backwards_counter;
+        bool destroyed; ///< Off the board, kept only to be reported
+    };
+
+    struct ShellState {
+        int id;
+        Position position;
+        Direction::DirectionType direction;
+        int owner_id;
+        int collision_id; ///< Id of the collision holding the shell over a mine, or -1
+    };
+
+    // Cell codes of a map layout, one per whole cell, row-major
+    static constexpr uint8_t EMPTY_CELL = 0;
+    static constexpr uint8_t MINE_CELL = 1;
+    // A wall with h hits left is WALL_CELL + h - 1
+    static constexpr uint8_t WALL_CELL = 2;
+
+    int next_object_id = 0;
+    std::vector<Position> cleared;  ///< Map walls and mines that are gone
+    std::vector<Position> weakened; ///< Map walls down to their last hit
+    std::vector<TankState> tanks;   ///< Alive tanks in board order, then destroyed ones in order of death
+    std::vector<ShellState> shells; ///< In id order
+};
+
+#endif //BOARD_STATE_H
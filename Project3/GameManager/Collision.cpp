@@ -15,7 +15,7 @@ bool Collision::validateCollision() {
     marked = true;
 
     for (auto it = elements.begin(); it != elements.end();) {
-        if (auto *shellPtr = dynamic_cast<Shell *>(it->get())) {
+        if (auto *shellPtr = objectCast<Shell>(it->get())) {
             if (shell != nullptr) {
                 break;
             }
@@ -23,7 +23,7 @@ bool Collision::validateCollision() {
             shell.reset(shellPtr);
             it->release();
             it = elements.erase(it);
-        } else if (auto *minePtr = dynamic_cast<Mine *>(it->get())) {
+        } else if (auto *minePtr = objectCast<Mine>(it->get())) {
             if (mine != nullptr) {
                 break;
             }
@@ -47,7 +47,7 @@ bool Collision::validateCollision() {
     }
 
     for (auto it = elements.begin(); it != elements.end();) {
-        if (auto *wallPtr = dynamic_cast<Wall *>(it->get())) {
+        if (auto *wallPtr = objectCast<Wall>(it->get())) {
             wallPtr->takeDamage();
             if (!wallPtr->isDestroyed()) hasWeakenedWall = true;
             else hasWeakenedWall = false;
@@ -64,10 +64,12 @@ std::unique_ptr<Wall> Collision::getWeakenedWall() {
     std::unique_ptr<Wall> weakenedWall = nullptr;
 
     for (auto it = elements.begin(); it != elements.end();) {
-        if (auto *wallPtr = dynamic_cast<Wall *>(it->get())) {
+        if (auto *wallPtr = objectCast<Wall>(it->get())) {
             setDirection(wallPtr->getDirection());
             weakenedWall.reset(wallPtr);
             it->release();
+            // Leave no empty slot behind: popElement() stops at the first one
+            elements.erase(it);
             return weakenedWall;
         }
         ++it;
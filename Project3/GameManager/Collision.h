@@ -6,6 +6,7 @@
 
 #include "GameObject.h"
 #include "Mine.h"
+#include "ObjectPool.h"
 #include "Shell.h"
 #include "Wall.h"
 
@@ -17,14 +18,20 @@ class Collision final : public GameObject {
     bool hasWeakenedWall = false;
 
 public:
+    static constexpr ObjectKind KIND = ObjectKind::COLLISION;
+
     explicit Collision(std::unique_ptr<GameObject> element1,
-                       std::unique_ptr<GameObject> element2): GameObject(element1->getPosition()),
+                       std::unique_ptr<GameObject> element2): GameObject(KIND, element1->getPosition()),
                                                               elements(std::vector<std::unique_ptr<GameObject> >(
                                                                   0)) {
         elements.push_back(std::move(element1));
         elements.push_back(std::move(element2));
     }
 
+    static void *operator new(const size_t size) { return ObjectPool<Collision>::allocate(size); }
+
+    static void operator delete(void *p, const size_t size) { ObjectPool<Collision>::deallocate(p, size); }
+
     std::unique_ptr<GameObject> popElement();
 
     char getSymbol() const override { return 'X'; }
@@ -33,8 +40,6 @@ public:
 
     bool validateCollision();
 
-    bool isCollision() const override { return true; }
-
     std::unique_ptr<Shell> getShell() { return std::move(shell); }
 
     Shell *getShellPtr() const { return shell.get(); }
@@ -1,5 +1,6 @@
 #include "GameManager.h"
 
+#include <algorithm>
 #include <iostream>
 #include <thread>
 #include <chrono>
@@ -16,7 +17,6 @@
 #include "Shell.h"
 #include "ActionRequest.h"
 #include "InputParser.h"
-#include "MySatelliteView.h"
 #include "Direction.h"
 
 // Use Direction::DirectionType instead of DirectionType
@@ -24,27 +24,54 @@
 using namespace std::chrono_literals;
 
 void GameManager::readBoard(const std::string &file_name) {
-    auto input_parser = InputParser();
+    map_file = file_name;
+    if (logging) logger.init(file_name);
+    else logger.mute();
+    Logger::Scope logger_scope(logger);
+    InputParser input_parser(logger);
     board = input_parser.parseInputFile(file_name);
 
     if (board == nullptr) {
         std::cerr << "Can't parse file " << file_name << std::endl;
+        logger.close(); // exit() skips the destructor, which would write what is still queued
         exit(1); // Exit with error code 1 when the board file can't be parsed
     }
+    map_layout = board->getMapLayout();
+    createPlayers(input_parser.getTanks());
+}
+
+/**
+ * @brief Reads the board from a map parsed earlier, without going back to the file
+ *
+ * Input errors of the map were logged when the template was loaded, so this game's
+ * log starts with its first step.
+ */
+void GameManager::readBoard(const MapTemplate &map) {
+    map_file = map.getFileName();
+    if (logging) logger.init(map_file);
+    else logger.mute();
+    board = map.newBoard();
+    map_layout = map.getMapLayout();
+    createPlayers(map.getTanks());
+}
 
+void GameManager::createPlayers(const std::vector<std::pair<int, int> > &map_tanks) {
     // create 2 players
     for (int i = 1; i <= 2; i++) {
-        players.emplace_back(player_factory.create(i, board->getWidth(), board->getHeight(), board->getMaxSteps(),
-                                                   board->getNumShells()));
+        players.emplace_back(player_factory(i, board->getWidth(), board->getHeight(), board->getMaxSteps(),
+                                            board->getNumShells()));
     }
 
-    for (auto [player_i, tank_i]: input_parser.getTanks()) {
-        tanks.emplace_back(tank_algorithm_factory.create(player_i, tank_i));
+    for (auto [player_i, tank_i]: map_tanks) {
+        tanks.emplace_back(tank_algorithm_factory(player_i, tank_i));
         tank_status.push_back({false, ActionRequest::DoNothing, true, false});
     }
+    budget.setTanks(map_tanks);
 }
 
 void GameManager::run() {
+    Logger::Scope logger_scope(logger);
+    if (!record_path.empty()) startRecord();
     checkDeaths(); //check if one of the player doesn't have any tanks
     
     // Display initial game state if in visual mode
@@ -57,12 +84,77 @@ void GameManager::run() {
         processStep();
     }
 
-    Logger::getInstance().logResult(getGameResult());
+    logger.logResult(getGameResult());
+    if (const std::string timeouts = budget.formatTimeouts(); !timeouts.empty()) logger.logResult(timeouts);
+    LOG_INFO(logger, budget.formatLatency());
+    if constexpr (profilingEnabled) logger.log(profile.format());
+    if (recorder != nullptr) {
+        recorder->finish(game_step, winner, getGameResult());
+        recorder.reset();
+    }
     if (visual) {
         std::cout << "\n" << getGameResult() << std::endl;
     }
 }
 
+void GameManager::setRecordFile(const std::string &path, const std::string &algorithm1,
+                                const std::string &algorithm2, const size_t keyframe_interval) {
+    record_path = path;
+    record_header.algorithm1 = algorithm1;
+    record_header.algorithm2 = algorithm2;
+    record_header.keyframe_interval = std::max<size_t>(keyframe_interval, 1);
+}
+
+void GameManager::startRecord() {
+    record_header.map_hash = hashMapFile(map_file);
+    record_header.map_name = map_file;
+    record_header.width = board->getWidth();
+    record_header.height = board->getHeight();
+    record_header.max_steps = board->getMaxSteps();
+    record_header.num_shells = board->getNumShells();
+    record_header.tank_count = tanks.size();
+
+    recorder = std::make_unique<GameRecordWriter>();
+    if (!recorder->open(record_path, record_header)) recorder.reset();
+}
+
+GameKeyframe GameManager::captureKeyframe() const {
+    GameKeyframe keyframe;
+    keyframe.step = game_step;
+    keyframe.empty_countdown = empty_countdown;
+    for (const auto &status: tank_status) {
+        keyframe.gone.push_back(std::get<0>(status));
+    }
+    keyframe.board = board->captureState(map_layout);
+    return keyframe;
+}
+
+/**
+ * @brief Puts a game that was just read with readBoard() at a keyframe of its record
+ */
+void GameManager::restore(const GameKeyframe &keyframe) {
+    board->restoreState(keyframe.board);
+    game_step = keyframe.step;
+    empty_countdown = keyframe.empty_countdown;
+    game_over = false;
+    winner = NO_WINNER;
+    for (size_t i = 0; i < tank_status.size() && i < keyframe.gone.size(); i++) {
+        const bool gone = keyframe.gone[i];
+        tank_status[i] = {gone, ActionRequest::DoNothing, true, gone};
+    }
+    // The next step takes a fresh picture of the restored board
+    snapshot = nullptr;
+    spare_snapshots.clear();
+}
+
+void GameManager::runTo(const size_t step) {
+    Logger::Scope logger_scope(logger);
+    checkDeaths();
+    while (!isGameOver() && game_step < step) {
+        processStep();
+    }
+}
+
 void GameManager::updateCounters(Tank &tank, const ActionRequest action) {
     tank.decreaseCooldown();
     const int back_counter = tank.getBackwardsCounter();
@@ -194,15 +286,61 @@ bool GameManager::shoot(Tank &tank) {
 bool GameManager::getBattleInfo(const Tank &tank, const size_t player_i) {
     const int tank_algo_i = tank.getTankAlgoIndex();
     auto [x,y] = tank.getPosition();
-    MySatelliteView satellite_view = this->satellite_view;
-    satellite_view.setObject(x, y, '%');
-    players[player_i - 1]->updateTankWithBattleInfo(*tanks[tank_algo_i], satellite_view);
+    UserCommon_123456789_987654321::SnapshotSatelliteView satellite_view(snapshot, x, y);
+    const auto start = std::chrono::steady_clock::now();
+    {
+        PROFILE_SCOPE(profile, player_i == 1 ? StepProfile::BATTLE_INFO_1 : StepProfile::BATTLE_INFO_2);
+        players[player_i - 1]->updateTankWithBattleInfo(*tanks[tank_algo_i], satellite_view);
+    }
+    // The information is delivered either way; a slow call only counts against the budget
+    budget.record(tank_algo_i, std::chrono::steady_clock::now() - start, game_step);
     return true;
 }
 
 void GameManager::updateSatelliteView() {
-    satellite_view.setDimensions(board->getWidth(), board->getHeight());
-    board->fillSatelliteView(satellite_view);
+    using UserCommon_123456789_987654321::BoardSnapshot;
+
+    if (snapshot == nullptr) {
+        snapshot = std::make_shared<BoardSnapshot>(board->getWidth(), board->getHeight());
+        board->fillSnapshot(*snapshot);
+        board->clearChanges();
+        return;
+    }
+
+    // Only the cells the board reports as changed are rewritten. Algorithms keep the snapshots
+    // they were handed, so one is only patched in place when nobody else holds it: the current
+    // picture if it is free, else the free spare closest to it, else a copy of it.
+    if (!board->hasChanges()) return;
+    const std::vector<uint32_t> &changes = board->getChanges();
+    if (snapshot.use_count() == 1) {
+        board->writeCells(*snapshot, changes);
+    } else {
+        auto spare = spare_snapshots.end();
+        for (auto it = spare_snapshots.begin(); it != spare_snapshots.end(); ++it) {
+            const bool closer = spare == spare_snapshots.end() || it->lag.size() < spare->lag.size();
+            if (it->snapshot.use_count() == 1 && closer) spare = it;
+        }
+        std::shared_ptr<BoardSnapshot> next;
+        if (spare != spare_snapshots.end()) {
+            next = std::move(spare->snapshot);
+            board->writeCells(*next, spare->lag);
+            spare_snapshots.erase(spare);
+        } else {
+            next = std::make_shared<BoardSnapshot>(*snapshot);
+        }
+        board->writeCells(*next, changes);
+        spare_snapshots.push_back({std::move(snapshot), {}});
+        snapshot = std::move(next);
+    }
+
+    // A spare that lags too far behind is cheaper to copy again than to catch up
+    const size_t max_lag = snapshot->getWidth() * snapshot->getHeight() / 4;
+    for (SpareSnapshot &spare: spare_snapshots) spare.lag.insert(spare.lag.end(), changes.begin(), changes.end());
+    spare_snapshots.erase(std::remove_if(spare_snapshots.begin(), spare_snapshots.end(),
+                                         [max_lag](const SpareSnapshot &spare) { return spare.lag.size() > max_lag; }),
+                          spare_snapshots.end());
+    if (spare_snapshots.size() > MAX_SPARE_SNAPSHOTS) spare_snapshots.erase(spare_snapshots.begin());
+    board->clearChanges();
 }
 
 bool GameManager::allEmptyAmmo() const {
@@ -216,7 +354,17 @@ bool GameManager::allEmptyAmmo() const {
 void GameManager::tanksTurn() {
     for (const auto tank: board->getAliveTanks()) {
         const int i = tank->getTankAlgoIndex();
-        const ActionRequest action = tanks[i]->getAction();
+        ActionRequest action = ActionRequest::DoNothing;
+        if (!budget.isTimedOut(i)) {
+            const auto start = std::chrono::steady_clock::now();
+            {
+                PROFILE_SCOPE(profile, tank->getPlayerIndex() == 1 ? StepProfile::GET_ACTION_1 : StepProfile::GET_ACTION_2);
+                action = tanks[i]->getAction();
+            }
+            if (!budget.record(i, std::chrono::steady_clock::now() - start, game_step)) {
+                action = ActionRequest::DoNothing;
+            }
+        }
         const bool res = tankAction(*tank, action);
         tank_status[i] = {false, action, res, false};
     }
@@ -239,22 +387,49 @@ void GameManager::shellsTurn() const {
 void GameManager::processStep() {
     if (game_over) return;
     game_step++;
+    PROFILE_SCOPE(profile, StepProfile::STEP);
 
-    updateSatelliteView();
-
-    shellsTurn();
-    board->finishMove();
-
-    shellsTurn();
-    tanksTurn();
-    board->finishMove();
+    {
+        PROFILE_SCOPE(profile, StepProfile::SATELLITE_VIEW);
+        updateSatelliteView();
+    }
+    {
+        PROFILE_SCOPE(profile, StepProfile::SHELLS_MOVE_1);
+        shellsTurn();
+    }
+    {
+        PROFILE_SCOPE(profile, StepProfile::FINISH_MOVE_1);
+        board->finishMove();
+    }
+    {
+        PROFILE_SCOPE(profile, StepProfile::SHELLS_MOVE_2);
+        shellsTurn();
+    }
+    {
+        PROFILE_SCOPE(profile, StepProfile::TANKS_TURN);
+        tanksTurn();
+    }
+    {
+        PROFILE_SCOPE(profile, StepProfile::FINISH_MOVE_2);
+        board->finishMove();
+    }
 
     if (visual) {
         displayGame();
     }
 
-    checkDeaths();
-    logStep();
+    {
+        PROFILE_SCOPE(profile, StepProfile::CHECK_DEATHS);
+        checkDeaths();
+    }
+    {
+        PROFILE_SCOPE(profile, StepProfile::LOG_STEP);
+        logStep();
+    }
+
+    if (recorder != nullptr && !game_over && game_step % record_header.keyframe_interval == 0) {
+        recorder->addKeyframe(captureKeyframe());
+    }
 }
 
 std::string GameManager::getGameResult() const {
@@ -287,7 +462,8 @@ void GameManager::logStep() {
         }
     }
 
-    Logger::getInstance().logActions(tank_status);
+    logger.logActions(tank_status);
+    if (recorder != nullptr) recorder->addStep(tank_status);
 
     // Update deaths
     for (size_t i = 0; i < tank_status.size(); i++) {
@@ -3,9 +3,14 @@
 #include <map>
 #include <fstream>
 
+#include "AlgorithmBudget.h"
 #include "Board.h"
-#include "PlayerFactory.h"
-#include "TankAlgorithmFactory.h"
+#include "GameRecord.h"
+#include "Logger.h"
+#include "MapTemplate.h"
+#include "StepProfile.h"
+#include "Player.h"
+#include "TankAlgorithm.h"
 #include "Tank.h"
 
 enum Winner {
@@ -23,22 +28,80 @@ class GameManager {
 
 public:
     GameManager(const PlayerFactory &player_factory, const TankAlgorithmFactory &tank_algorithm_factory)
-        : player_factory(player_factory), tank_algorithm_factory(tank_algorithm_factory),
-          satellite_view(MySatelliteView()) {
+        : player_factory(player_factory), tank_algorithm_factory(tank_algorithm_factory) {
     }
 
     void readBoard(const std::string &file_name);
 
+    // Starts the game on a copy of a map that was read once for many games
+    void readBoard(const MapTemplate &map);
+
     void run();
 
     void updateCounters(Tank &tank, ActionRequest action);
 
     void setVisual(bool visual) { this->visual = visual; }
-    
+
+    // Without logs the game writes no output files; set before readBoard()
+    void setLogging(bool logging) { this->logging = logging; }
+
+    /**
+     * @brief Records the game to a binary file while it runs (see GameRecord.h)
+     *
+     * @param path Record file to create
+     * @param algorithm1 Name of player 1's algorithm, stored in the header
+     * @param algorithm2 Name of player 2's algorithm, stored in the header
+     * @param keyframe_interval Steps between two keyframes
+     */
+    void setRecordFile(const std::string &path, const std::string &algorithm1, const std::string &algorithm2,
+                       size_t keyframe_interval = DEFAULT_KEYFRAME_INTERVAL);
+
+    /**
+     * @brief Limits the time the tank algorithms may take (see AlgorithmBudget); zero is no limit
+     *
+     * @param per_call Longest one getAction or updateTankWithBattleInfo call may take
+     * @param per_game Time one tank's algorithm may take over the whole game
+     */
+    void setAlgorithmBudget(AlgorithmBudget::Duration per_call, AlgorithmBudget::Duration per_game) {
+        budget.setLimits(per_call, per_game);
+    }
+
+    // Latency of every tank's algorithm calls so far, and which tanks timed out
+    const AlgorithmBudget &getAlgorithmBudget() const { return budget; }
+
+    // Replay support: a game read with readBoard() can be put at a keyframe and stepped
+    void restore(const GameKeyframe &keyframe);
+
+    // Plays steps until the given one is done or the game is over
+    void runTo(size_t step);
+
+    GameKeyframe captureKeyframe() const;
+
+    size_t getStep() const { return game_step; }
+
+    bool isGameOver() const { return game_over; }
+
+    std::string getGameResult() const;
+
+    const Board &getBoard() const { return *board; }
+
+    // Time spent in each phase so far; only filled when built with TANK_PROFILE=1
+    const StepProfile &getProfile() const { return profile; }
+
 private:
     static constexpr int max_steps_empty_ammo = 40;
+    static constexpr size_t DEFAULT_KEYFRAME_INTERVAL = 64;
 
     bool visual = false;
+    bool logging = true;
+    std::string map_file;
+    // Walls and mines of the map, which keyframes are relative to
+    std::vector<uint8_t> map_layout;
+    std::string record_path;
+    GameRecordHeader record_header;
+    std::unique_ptr<GameRecordWriter> recorder;
+    // Output of this game only; bound to the running thread while algorithms are called
+    Logger logger;
     size_t game_step = 0;
     bool game_over = false;
     Winner winner = NO_WINNER;
@@ -48,7 +111,19 @@ private:
     std::vector<std::unique_ptr<Player> > players;
     std::vector<std::unique_ptr<TankAlgorithm> > tanks;
     std::vector<std::vector<std::string>> visualBoard;
-    MySatelliteView satellite_view;
+    StepProfile profile;
+    AlgorithmBudget budget;
+    // Board picture taken at the start of the step, shared by every GetBattleInfo of that step
+    std::shared_ptr<UserCommon_123456789_987654321::BoardSnapshot> snapshot;
+    // Earlier steps' pictures, oldest first; one no algorithm holds any more is patched into the next picture
+    struct SpareSnapshot {
+        std::shared_ptr<UserCommon_123456789_987654321::BoardSnapshot> snapshot;
+        std::vector<uint32_t> lag; ///< Cells changed since it was the current picture
+    };
+    static constexpr size_t MAX_SPARE_SNAPSHOTS = 4;
+    std::vector<SpareSnapshot> spare_snapshots;
+
+    void createPlayers(const std::vector<std::pair<int, int> > &map_tanks);
 
     bool tankAction(Tank &tank, ActionRequest action);
 
@@ -74,9 +149,7 @@ private:
 
     void processStep();
 
-    bool isGameOver() const { return game_over; }
-
-    std::string getGameResult() const;
+    void startRecord();
 
     void logStep();
 
@@ -1,6 +1,8 @@
 #ifndef GAME_OBJECT_H
 #define GAME_OBJECT_H
 
+#include <cstdint>
+
 #include "Direction.h"
 
 // Define CellType enum
@@ -13,7 +15,14 @@ enum class CellType {
     SHELL
 };
 
-static int static_id = 0;
+// Concrete type of a GameObject, so the board can classify objects without dynamic_cast
+enum class ObjectKind : uint8_t {
+    WALL,
+    MINE,
+    TANK,
+    SHELL,
+    COLLISION,
+};
 
 class GameObject {
     GameObject(const GameObject &) = delete;
@@ -24,34 +33,42 @@ class GameObject {
 
     GameObject &operator=(GameObject &&) = delete;
 
+    const ObjectKind kind;
+
 protected:
-    int id;
+    int id = NO_ID;
     Position position;
     Direction::DirectionType direction = Direction::UP;
     bool destroyed = false;
 
 public:
+    // Id of an object that was never placed on a board
+    static constexpr int NO_ID = -1;
+
     virtual ~GameObject() = default;
 
-    explicit GameObject(const Position position,
-                        const Direction::DirectionType direction): id(static_id++), position(position),
-                                                                   direction(direction) { }
+    explicit GameObject(const ObjectKind kind, const Position position,
+                        const Direction::DirectionType direction): kind(kind), position(position), direction(direction) { }
+
+    explicit GameObject(const ObjectKind kind, const Position position): kind(kind), position(position) { }
 
-    explicit GameObject(const Position position): id(static_id++), position(position) { }
+    [[nodiscard]] ObjectKind getKind() const { return kind; }
 
     [[nodiscard]] virtual char getSymbol() const { return ' '; }
     [[nodiscard]] virtual bool isDestroyed() const { return destroyed; }
     [[nodiscard]] virtual Position getPosition() const { return position; }
     [[nodiscard]] virtual Direction::DirectionType getDirection() const { return direction; }
     virtual int getId() const { return id; }
+    // Ids are handed out by the board the object is first placed on, so they are unique within one game
+    void assignId(const int new_id) { id = new_id; }
     virtual void setPosition(const Position pos) { position = pos; }
     virtual void setDirection(const Direction::DirectionType &dir) { direction = dir; }
     virtual void destroy() { destroyed = true; }
-    virtual bool isWall() const { return false; }
-    virtual bool isShell() const { return false; }
-    virtual bool isMine() const { return false; }
-    virtual bool isCollision() const { return false; }
-    virtual bool isTank() const { return false; }
+    bool isWall() const { return kind == ObjectKind::WALL; }
+    bool isShell() const { return kind == ObjectKind::SHELL; }
+    bool isMine() const { return kind == ObjectKind::MINE; }
+    bool isCollision() const { return kind == ObjectKind::COLLISION; }
+    bool isTank() const { return kind == ObjectKind::TANK; }
     
     // Add missing virtual methods
     virtual void setObjectType(CellType type) { (void)type; /* Default implementation does nothing */ }
@@ -67,4 +84,18 @@ public:
     friend std::ostream &lessThenOperator(std::ostream &os, const GameObject &element);
 };
 
+/**
+ * Checked downcast by kind: returns object as a T, or nullptr if it is of another kind.
+ * T is Tank, Shell, Mine, Collision or Wall (which also matches WeakWall).
+ */
+template<typename T>
+T *objectCast(GameObject *object) {
+    return object != nullptr && object->getKind() == T::KIND ? static_cast<T *>(object) : nullptr;
+}
+
+template<typename T>
+const T *objectCast(const GameObject *object) {
+    return object != nullptr && object->getKind() == T::KIND ? static_cast<const T *>(object) : nullptr;
+}
+
 #endif //GAME_OBJECT_H
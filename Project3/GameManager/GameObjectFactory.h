@@ -1,16 +1,22 @@
 #ifndef GAMEOBJECTFACTORY_H
 #define GAMEOBJECTFACTORY_H
 
+#include <array>
 #include <memory>
 
 #include "GameObject.h"
+#include "Tank.h"
 
-
+/**
+ * Creates the objects of one map. Tank numbering is kept per factory, so every
+ * game that parses its own map numbers its tanks from zero.
+ */
 class GameObjectFactory {
-    static int tank_algo_count;
+    int tank_algo_count = 0;
+    std::array<int, MAX_PLAYERS> tank_count{};
 
 public:
-    static std::unique_ptr<GameObject> create(char symbol, Position position, size_t shells_count);
+    std::unique_ptr<GameObject> create(char symbol, Position position, size_t shells_count);
 };
 
 
@@ -0,0 +1,363 @@
+#include "GameRecord.h"
+
+#include <algorithm>
+#include <iostream>
+#include <iterator>
+
+namespace {
+constexpr char MAGIC[] = {'T', 'K', 'R', 'P'};
+constexpr uint8_t VERSION = 1;
+
+constexpr char ACTIONS_BLOCK = 'A';
+constexpr char KEYFRAME_BLOCK = 'K';
+constexpr char RESULT_BLOCK = 'R';
+
+void putVarint(std::string &out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+// Zigzag encoding, so small negative values stay one byte
+void putSigned(std::string &out, const int64_t value) {
+    putVarint(out, static_cast<uint64_t>(value) << 1 ^ static_cast<uint64_t>(value >> 63));
+}
+
+void putString(std::string &out, const std::string &text) {
+    putVarint(out, text.size());
+    out += text;
+}
+
+void putPosition(std::string &out, const Position pos) {
+    putVarint(out, static_cast<uint64_t>(pos.x));
+    putVarint(out, static_cast<uint64_t>(pos.y));
+}
+
+void putDirection(std::string &out, const Direction::DirectionType dir) {
+    out.push_back(static_cast<char>(dir / 45));
+}
+
+/**
+ * @brief Reads the encodings above back; any read past the end clears ok and returns 0
+ */
+class Cursor {
+    const uint8_t *pos;
+    const uint8_t *end;
+
+public:
+    bool ok = true;
+
+    Cursor(const uint8_t *begin, const uint8_t *end) : pos(begin), end(end) {
+    }
+
+    [[nodiscard]] bool atEnd() const { return pos == end; }
+
+    uint8_t byte() {
+        if (pos == end) {
+            ok = false;
+            return 0;
+        }
+        return *pos++;
+    }
+
+    uint64_t varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uint8_t b = byte();
+            value |= static_cast<uint64_t>(b & 0x7F) << shift;
+            if ((b & 0x80) == 0) return value;
+        }
+        ok = false;
+        return 0;
+    }
+
+    int64_t signedVarint() {
+        const uint64_t value = varint();
+        return static_cast<int64_t>(value >> 1 ^ (~(value & 1) + 1));
+    }
+
+    const uint8_t *bytes(const size_t count) {
+        if (static_cast<size_t>(end - pos) < count) {
+            ok = false;
+            pos = end;
+            return nullptr;
+        }
+        const uint8_t *start = pos;
+        pos += count;
+        return start;
+    }
+
+    std::string string() {
+        const size_t length = varint();
+        const uint8_t *start = bytes(length);
+        return start == nullptr ? std::string() : std::string(reinterpret_cast<const char *>(start), length);
+    }
+
+    Position position() {
+        const int x = static_cast<int>(varint());
+        const int y = static_cast<int>(varint());
+        return {x, y};
+    }
+
+    Direction::DirectionType direction() {
+        return Direction::getDirectionFromIndex(byte());
+    }
+};
+
+bool decodeKeyframe(Cursor &in, GameKeyframe &keyframe, const size_t tank_count) {
+    keyframe.step = in.varint();
+    keyframe.empty_countdown = static_cast<int>(in.signedVarint());
+    keyframe.gone.assign(tank_count, false);
+    const uint8_t *gone = in.bytes((tank_count + 7) / 8);
+    if (gone == nullptr) return false;
+    for (size_t i = 0; i < tank_count; i++) {
+        keyframe.gone[i] = (gone[i / 8] >> (i % 8) & 1) != 0;
+    }
+
+    BoardState &board = keyframe.board;
+    board.next_object_id = static_cast<int>(in.varint());
+    for (auto *cells: {&board.cleared, &board.weakened}) {
+        cells->resize(in.varint());
+        for (auto &pos: *cells) pos = in.position();
+        if (!in.ok) return false;
+    }
+
+    board.tanks.resize(in.varint());
+    for (auto &tank: board.tanks) {
+        tank.id = static_cast<int>(in.varint());
+        tank.position = in.position();
+        tank.player_index = in.byte();
+        tank.tank_index = static_cast<int>(in.varint());
+        tank.tank_algo_index = static_cast<int>(in.varint());
+        tank.direction = in.direction();
+        tank.ammunition = static_cast<int>(in.varint());
+        tank.cooldown = static_cast<int>(in.varint());
+        tank.backwards_counter = static_cast<int>(in.varint());
+        tank.destroyed = in.byte() != 0;
+        if (!in.ok) return false;
+    }
+
+    board.shells.resize(in.varint());
+    for (auto &shell: board.shells) {
+        shell.id = static_cast<int>(in.varint());
+        shell.position = in.position();
+        shell.direction = in.direction();
+        shell.owner_id = static_cast<int>(in.signedVarint());
+        shell.collision_id = static_cast<int>(in.signedVarint());
+        if (!in.ok) return false;
+    }
+    return in.ok;
+}
+}
+
+uint64_t hashMapFile(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return 0;
+
+    uint64_t hash = 14695981039346656037ull;
+    char buffer[1 << 16];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+        for (std::streamsize i = 0; i < file.gcount(); i++) {
+            hash ^= static_cast<uint8_t>(buffer[i]);
+            hash *= 1099511628211ull;
+        }
+    }
+    return hash;
+}
+
+std::string encodeKeyframe(const GameKeyframe &keyframe) {
+    std::string out;
+    putVarint(out, keyframe.step);
+    putSigned(out, keyframe.empty_countdown);
+    std::string gone((keyframe.gone.size() + 7) / 8, '\0');
+    for (size_t i = 0; i < keyframe.gone.size(); i++) {
+        if (keyframe.gone[i]) gone[i / 8] = static_cast<char>(gone[i / 8] | 1 << (i % 8));
+    }
+    out += gone;
+
+    const BoardState &board = keyframe.board;
+    putVarint(out, static_cast<uint64_t>(board.next_object_id));
+    for (const auto *cells: {&board.cleared, &board.weakened}) {
+        putVarint(out, cells->size());
+        for (const Position pos: *cells) putPosition(out, pos);
+    }
+
+    putVarint(out, board.tanks.size());
+    for (const auto &tank: board.tanks) {
+        putVarint(out, static_cast<uint64_t>(tank.id));
+        putPosition(out, tank.position);
+        out.push_back(static_cast<char>(tank.player_index));
+        putVarint(out, static_cast<uint64_t>(tank.tank_index));
+        putVarint(out, static_cast<uint64_t>(tank.tank_algo_index));
+        putDirection(out, tank.direction);
+        putVarint(out, static_cast<uint64_t>(tank.ammunition));
+        putVarint(out, static_cast<uint64_t>(tank.cooldown));
+        putVarint(out, static_cast<uint64_t>(tank.backwards_counter));
+        out.push_back(static_cast<char>(tank.destroyed));
+    }
+
+    putVarint(out, board.shells.size());
+    for (const auto &shell: board.shells) {
+        putVarint(out, static_cast<uint64_t>(shell.id));
+        putPosition(out, shell.position);
+        putDirection(out, shell.direction);
+        putSigned(out, shell.owner_id);
+        putSigned(out, shell.collision_id);
+    }
+    return out;
+}
+
+bool GameRecordWriter::open(const std::string &path, const GameRecordHeader &header) {
+    file.open(path, std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open record file: " << path << std::endl;
+        return false;
+    }
+    stride = (header.tank_count + 1) / 2;
+    pending_actions.clear();
+    pending_steps = 0;
+
+    std::string out(MAGIC, sizeof(MAGIC));
+    out.push_back(static_cast<char>(VERSION));
+    for (int i = 0; i < 8; i++) out.push_back(static_cast<char>(header.map_hash >> 8 * i));
+    putString(out, header.map_name);
+    for (const size_t value: {header.width, header.height, header.max_steps, header.num_shells,
+                              header.tank_count, header.keyframe_interval}) {
+        putVarint(out, value);
+    }
+    putString(out, header.algorithm1);
+    putString(out, header.algorithm2);
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    return true;
+}
+
+void GameRecordWriter::addStep(const std::vector<std::tuple<bool, ActionRequest, bool, bool> > &tank_status) {
+    if (!file.is_open()) return;
+    const size_t row = pending_actions.size();
+    pending_actions.resize(row + stride, '\0');
+    for (size_t i = 0; i < tank_status.size(); i++) {
+        const auto &[gone, action, result, killed] = tank_status[i];
+        const uint8_t code = gone ? NO_ACTION : static_cast<uint8_t>(action);
+        char &packed = pending_actions[row + i / 2];
+        packed = static_cast<char>(packed | code << (i % 2 * 4));
+    }
+    pending_steps++;
+}
+
+void GameRecordWriter::flushActions() {
+    if (pending_steps == 0) return;
+    std::string out(1, ACTIONS_BLOCK);
+    putVarint(out, pending_steps);
+    out += pending_actions;
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    pending_actions.clear();
+    pending_steps = 0;
+}
+
+void GameRecordWriter::addKeyframe(const GameKeyframe &keyframe) {
+    if (!file.is_open()) return;
+    flushActions();
+    const std::string body = encodeKeyframe(keyframe);
+    std::string out(1, KEYFRAME_BLOCK);
+    putVarint(out, body.size());
+    out += body;
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+}
+
+void GameRecordWriter::finish(const size_t steps, const int winner, const std::string &result) {
+    if (!file.is_open()) return;
+    flushActions();
+    std::string out(1, RESULT_BLOCK);
+    putVarint(out, steps);
+    out.push_back(static_cast<char>(winner));
+    putString(out, result);
+    file.write(out.data(), static_cast<std::streamsize>(out.size()));
+    file.close();
+}
+
+bool GameRecordReader::load(const std::string &path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open record file: " << path << std::endl;
+        return false;
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    Cursor in(bytes.data(), bytes.data() + bytes.size());
+    const uint8_t *magic = in.bytes(sizeof(MAGIC));
+    if (magic == nullptr || !std::equal(MAGIC, MAGIC + sizeof(MAGIC), magic)) {
+        std::cerr << "Not a game record: " << path << std::endl;
+        return false;
+    }
+    if (const uint8_t version = in.byte(); version != VERSION) {
+        std::cerr << "Unsupported record version " << static_cast<int>(version) << ": " << path << std::endl;
+        return false;
+    }
+
+    header = GameRecordHeader();
+    for (int i = 0; i < 8; i++) header.map_hash |= static_cast<uint64_t>(in.byte()) << 8 * i;
+    header.map_name = in.string();
+    for (size_t *value: {&header.width, &header.height, &header.max_steps, &header.num_shells,
+                         &header.tank_count, &header.keyframe_interval}) {
+        *value = in.varint();
+    }
+    header.algorithm1 = in.string();
+    header.algorithm2 = in.string();
+    stride = (header.tank_count + 1) / 2;
+
+    step_count = 0;
+    actions.clear();
+    keyframes.clear();
+    has_result = false;
+    while (in.ok && !in.atEnd()) {
+        switch (in.byte()) {
+            case ACTIONS_BLOCK: {
+                const size_t count = in.varint();
+                const uint8_t *rows = count <= bytes.size() ? in.bytes(count * stride) : nullptr;
+                if (rows == nullptr) in.ok = false;
+                else actions.insert(actions.end(), rows, rows + count * stride);
+                step_count += count;
+                break;
+            }
+            case KEYFRAME_BLOCK: {
+                const size_t length = in.varint();
+                const uint8_t *body = in.bytes(length);
+                GameKeyframe keyframe;
+                Cursor keyframe_in(body, body == nullptr ? nullptr : body + length);
+                if (body == nullptr || !decodeKeyframe(keyframe_in, keyframe, header.tank_count)) in.ok = false;
+                else keyframes.push_back(std::move(keyframe));
+                break;
+            }
+            case RESULT_BLOCK:
+                result_steps = in.varint();
+                winner = in.byte();
+                result = in.string();
+                has_result = in.ok;
+                break;
+            default:
+                in.ok = false;
+        }
+    }
+
+    if (!in.ok) {
+        std::cerr << "Corrupt game record: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+ActionRequest GameRecordReader::getAction(const size_t step, const size_t tank_algo_index) const {
+    if (step == 0 || step > step_count || tank_algo_index >= header.tank_count) return ActionRequest::DoNothing;
+    const uint8_t packed = actions[(step - 1) * stride + tank_algo_index / 2];
+    const uint8_t code = packed >> (tank_algo_index % 2 * 4) & 0xF;
+    if (code > static_cast<uint8_t>(ActionRequest::DoNothing)) return ActionRequest::DoNothing;
+    return static_cast<ActionRequest>(code);
+}
+
+const GameKeyframe *GameRecordReader::keyframeAt(const size_t step) const {
+    const auto it = std::upper_bound(keyframes.begin(), keyframes.end(), step,
+                                     [](const size_t s, const GameKeyframe &keyframe) { return s < keyframe.step; });
+    return it == keyframes.begin() ? nullptr : &*std::prev(it);
+}
@@ -0,0 +1,135 @@
+#ifndef GAME_RECORD_H
+#define GAME_RECORD_H
+
+/**
+ * @file GameRecord.h
+ * @brief Compact binary record of a game, replayable to any step
+ *
+ * A record holds everything needed to play a game again on the same map:
+ *
+ *   "TKRP" version:u8
+ *   map_hash:u64 map_name width height max_steps num_shells tank_count keyframe_interval algorithm1 algorithm2
+ *   blocks, each starting with a tag byte:
+ *     'A' count, then count steps of packed actions
+ *     'K' length, then one keyframe
+ *     'R' steps winner:u8 result
+ *
+ * Numbers are LEB128 varints unless a width is given, strings are a length and
+ * their bytes. A step of actions is one nibble per tank in tank algorithm order
+ * (low nibble first): the ActionRequest the tank played, or NO_ACTION if it was
+ * already gone. A keyframe is the game state after its step, so seeking to a
+ * step only replays the actions after the last keyframe before it.
+ */
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ActionRequest.h"
+#include "BoardState.h"
+
+// Game state between two steps, written every keyframe_interval steps
+struct GameKeyframe {
+    size_t step = 0;
+    int empty_countdown = -1;
+    std::vector<bool> gone; ///< Per tank algorithm index, tanks destroyed in an earlier step
+    BoardState board;
+};
+
+struct GameRecordHeader {
+    uint64_t map_hash = 0;
+    std::string map_name;
+    size_t width = 0;
+    size_t height = 0;
+    size_t max_steps = 0;
+    size_t num_shells = 0;
+    size_t tank_count = 0;
+    size_t keyframe_interval = 0;
+    std::string algorithm1;
+    std::string algorithm2;
+};
+
+/**
+ * @brief FNV-1a hash of a file's bytes, used to match a record with its map
+ * @return The hash, or 0 if the file can't be read
+ */
+uint64_t hashMapFile(const std::string &path);
+
+// Bytes of a keyframe as stored in a record; equal states give equal bytes
+std::string encodeKeyframe(const GameKeyframe &keyframe);
+
+class GameRecordWriter {
+public:
+    static constexpr uint8_t NO_ACTION = 0xF;
+
+    /**
+     * @brief Creates the record file and writes its header
+     * @return false if the file could not be opened
+     */
+    bool open(const std::string &path, const GameRecordHeader &header);
+
+    // Appends the actions of one step, as kept by the game manager for its output
+    void addStep(const std::vector<std::tuple<bool, ActionRequest, bool, bool> > &tank_status);
+
+    void addKeyframe(const GameKeyframe &keyframe);
+
+    // Writes the result and closes the file
+    void finish(size_t steps, int winner, const std::string &result);
+
+private:
+    std::ofstream file;
+    size_t stride = 0;           ///< Bytes per step of actions
+    std::string pending_actions; ///< Steps not written yet, flushed as one block
+    size_t pending_steps = 0;
+
+    void flushActions();
+};
+
+class GameRecordReader {
+public:
+    /**
+     * @brief Reads a whole record file
+     * @return false, after printing why, if it is not a valid record
+     */
+    bool load(const std::string &path);
+
+    const GameRecordHeader &getHeader() const { return header; }
+
+    size_t getStepCount() const { return step_count; }
+
+    /**
+     * @brief Action a tank played at a step
+     * @param step Step number, from 1
+     * @param tank_algo_index Index of the tank's algorithm
+     * @return The action, or DoNothing if none was recorded
+     */
+    ActionRequest getAction(size_t step, size_t tank_algo_index) const;
+
+    // Last keyframe taken at or before step, nullptr if the game has to start from the map
+    const GameKeyframe *keyframeAt(size_t step) const;
+
+    const std::vector<GameKeyframe> &getKeyframes() const { return keyframes; }
+
+    bool hasResult() const { return has_result; }
+
+    size_t getResultSteps() const { return result_steps; }
+
+    int getWinner() const { return winner; }
+
+    const std::string &getResult() const { return result; }
+
+private:
+    GameRecordHeader header;
+    size_t stride = 0;
+    size_t step_count = 0;
+    std::vector<uint8_t> actions; ///< step_count rows of stride bytes
+    std::vector<GameKeyframe> keyframes;
+    bool has_result = false;
+    size_t result_steps = 0;
+    int winner = 0;
+    std::string result;
+};
+
+#endif //GAME_RECORD_H
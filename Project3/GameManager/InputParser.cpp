@@ -1,25 +1,36 @@
 #include "InputParser.h"
 
-#include <fstream>
+#include <algorithm>
 #include <iostream>
 
 #include "Board.h"
-#include "Logger.h"
-#include "GameObjectFactory.h"
+#include "MappedFile.h"
 #include "StringUtils.h"
 
+namespace {
+// Symbols a map may contain, as a table indexed by byte
+constexpr std::array<bool, 256> makeValidSymbols() {
+    std::array<bool, 256> valid{};
+    for (const char c: {'1', '2', '@', '#', '=', ' '}) valid[static_cast<unsigned char>(c)] = true;
+    return valid;
+}
+
+constexpr std::array<bool, 256> valid_symbols = makeValidSymbols();
+}
+
 void InputParser::addErrorMessage(const std::string &message) {
     error_messages.push_back(message);
 }
 
-bool InputParser::parseBoardConfig(std::ifstream &inFile,
+bool InputParser::parseBoardConfig(LineScanner &lines,
                                    size_t &retrieved_data,
                                    const std::string &expected_field_name) {
-    std::string line;
-    if (!std::getline(inFile, line)) {
+    std::string_view line_view;
+    if (!lines.next(line_view)) {
         addErrorMessage("Failed to extract line from file.");
         return false;
     }
+    const std::string line(line_view);
     const char delimiter = '=';
     auto split_line = StringUtils::split_and_trim(line, delimiter);
 
@@ -33,43 +44,71 @@ bool InputParser::parseBoardConfig(std::ifstream &inFile,
     return true;
 }
 
-void InputParser::populateBoard(std::ifstream &inFile) {
-    std::string line;
+void InputParser::populateBoard(LineScanner &lines) {
+    cells.assign(width * height, default_symbol);
+    object_count = 0;
+
+    std::string_view line;
     for (size_t row = 0; row < height; ++row) {
-        if (!std::getline(inFile, line)) {
+        if (!lines.next(line)) {
             addErrorMessage("Map is shorter than specified height");
             line = " ";
         }
         processLine(row, line);
         validateLineLength(row, line);
     }
-    if (std::getline(inFile, line)) {
+    if (lines.next(line)) {
         addErrorMessage("Map is longer than specified height");
     }
+
+    placeObjects();
 }
 
-void InputParser::processLine(size_t row, const std::string &line) {
-    for (size_t col = 0; col < width; ++col) {
-        char symbol = col < line.length() ? line[col] : ' ';
+/**
+ * @brief Copies the checked symbols of one map row into the cell grid
+ *
+ * Cells past the end of the line keep the default symbol.
+ */
+void InputParser::processLine(const size_t row, const std::string_view line) {
+    char *out = cells.data() + row * width;
+    const size_t length = std::min(width, line.length());
+    for (size_t col = 0; col < length; ++col) {
+        char symbol = line[col];
 
         if (!isValidSymbol(symbol)) {
             addErrorMessage("Unknown symbol '" + std::string{symbol} + "'");
             symbol = default_symbol;
         }
 
-        auto obj = GameObjectFactory::create(symbol, Position(col, row), shells_count);
-        if (const auto t = dynamic_cast<Tank *>(obj.get())) {
-            tanks.push_back({t->getPlayerIndex(), t->getTankIndex()});
+        out[col] = symbol;
+        object_count += symbol != default_symbol;
+    }
+}
+
+/**
+ * @brief Creates the objects of the cell grid on the board, row by row
+ */
+void InputParser::placeObjects() {
+    board->reserveObjects(object_count);
+    for (size_t row = 0; row < height; ++row) {
+        const char *symbols = cells.data() + row * width;
+        for (size_t col = 0; col < width; ++col) {
+            if (symbols[col] == default_symbol) continue;
+
+            auto obj = object_factory.create(symbols[col], Position(col, row), shells_count);
+            if (const auto t = objectCast<Tank>(obj.get())) {
+                tanks.push_back({t->getPlayerIndex(), t->getTankIndex()});
+            }
+            board->placeMapObject(std::move(obj));
         }
-        board->placeObject(std::move(obj));
     }
 }
 
-bool InputParser::isValidSymbol(char c) {
-    return validSymbols.find(c) != validSymbols.end();
+bool InputParser::isValidSymbol(const char c) {
+    return valid_symbols[static_cast<unsigned char>(c)];
 }
 
-void InputParser::validateLineLength(size_t row, const std::string &line) {
+void InputParser::validateLineLength(const size_t row, const std::string_view line) {
     if (line.length() > width) {
         addErrorMessage("Line " + std::to_string(row + 1) + " is longer than specified width");
     } else if (line.length() < width) {
@@ -77,18 +116,20 @@ void InputParser::validateLineLength(size_t row, const std::string &line) {
     }
 }
 
-bool InputParser::parseBoardInfo(std::ifstream &inFile) {
+bool InputParser::parseBoardInfo(LineScanner &lines) {
     std::string board_info;
 
-    if (!std::getline(inFile, board_description)) {
+    std::string_view description;
+    if (!lines.next(description)) {
         addErrorMessage("Failed to extract board info (board title + board description).");
         return false;
     }
+    board_description = std::string(description);
 
     board_info += "Board description: " + board_description;
 
-    auto checkParse = [this, &inFile, &board_info](size_t &field, const std::string &field_name) {
-        if (!parseBoardConfig(inFile, field, field_name)) {
+    auto checkParse = [this, &lines, &board_info](size_t &field, const std::string &field_name) {
+        if (!parseBoardConfig(lines, field, field_name)) {
             addErrorMessage("Failed to extract " + field_name + " from file.");
             return false;
         }
@@ -101,34 +142,34 @@ bool InputParser::parseBoardInfo(std::ifstream &inFile) {
         !checkParse(width, "Cols")) {
         return false;
     }
-    Logger::getInstance().log("Board Info Read: " + board_info);
+    LOG_INFO(logger, "Board Info Read: " + board_info);
     return true;
 }
 
 void InputParser::addErrorMessagesToLog() {
     for (const std::string &msg: error_messages) {
-        Logger::getInstance().inputError(msg);
+        logger.inputError(msg);
     }
 }
 
 std::unique_ptr<Board> InputParser::parseInputFile(const std::string &file_name) {
-    Logger::getInstance().log("Parsing file:  " + file_name);
-    std::ifstream inFile(file_name);
-    if (!inFile) {
+    LOG_INFO(logger, "Parsing file:  " + file_name);
+    MappedFile file;
+    if (!file.open(file_name)) {
         std::cerr << "error: failed to create board. Could not open file " << file_name << " for reading.\n";
         addErrorMessage("error while opening file " + file_name);
         addErrorMessagesToLog();
         return nullptr;
     }
-    if (!parseBoardInfo(inFile)) {
+    LineScanner lines(file.view());
+    if (!parseBoardInfo(lines)) {
         addErrorMessagesToLog();
         return nullptr;
     }
 
     board = std::make_unique<Board>(board_description, max_steps, shells_count, width, height);
-    populateBoard(inFile);
-    Logger::getInstance().log("Board loaded successfully");
-    inFile.close();
+    populateBoard(lines);
+    LOG_INFO(logger, "Board loaded successfully");
 
     addErrorMessagesToLog();
     return std::move(board);
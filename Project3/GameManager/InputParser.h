@@ -1,11 +1,17 @@
 #ifndef INPUTPARSER_H
 #define INPUTPARSER_H
 
-#include <unordered_set>
+#include <array>
+#include <string_view>
 
 #include "Board.h"
+#include "GameObjectFactory.h"
+#include "LineScanner.h"
+#include "Logger.h"
 
 class InputParser {
+    Logger &logger;
+    GameObjectFactory object_factory;
     std::vector<std::string> error_messages;
     std::unique_ptr<Board> board;
     std::string board_description;
@@ -14,22 +20,26 @@ class InputParser {
     size_t max_steps{};
     size_t shells_count{};
     std::vector<std::pair<int, int> > tanks;
-    const char default_symbol = ' ';
-    const std::unordered_set<char> validSymbols = {'1', '2', '@', '#', '=', ' '};
+    static constexpr char default_symbol = ' ';
+    // Symbol of every map cell, row-major, checked and padded with default_symbol
+    std::vector<char> cells;
+    size_t object_count{};
 
-    bool parseBoardConfig(std::ifstream &inFile, size_t &retrieved_data, const std::string &expected_field_name);
+    bool parseBoardConfig(LineScanner &lines, size_t &retrieved_data, const std::string &expected_field_name);
 
-    void populateBoard(std::ifstream &inFile);
+    void populateBoard(LineScanner &lines);
+
+    void placeObjects();
 
     void addErrorMessage(const std::string &message);
 
-    void processLine(size_t row, const std::string &line);
+    void processLine(size_t row, std::string_view line);
 
-    bool isValidSymbol(char c);
+    static bool isValidSymbol(char c);
 
-    void validateLineLength(size_t row, const std::string &line);
+    void validateLineLength(size_t row, std::string_view line);
 
-    bool parseBoardInfo(std::ifstream &inFile);
+    bool parseBoardInfo(LineScanner &lines);
 
     void addErrorMessagesToLog();
 
@@ -42,7 +52,7 @@ class InputParser {
     InputParser &operator=(InputParser &&) = delete;
 
 public:
-    InputParser() = default;
+    explicit InputParser(Logger &logger) : logger(logger) {}
 
     std::unique_ptr<Board> parseInputFile(const std::string &file_name);
 
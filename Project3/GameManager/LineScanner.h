@@ -0,0 +1,63 @@
+#ifndef LINE_SCANNER_H
+#define LINE_SCANNER_H
+
+#include <cstring>
+#include <string_view>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define LINE_SCANNER_SSE2 1
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * Splits text into lines in place, with the same results as calling
+ * std::getline on a stream of that text: the newline is dropped, a last line
+ * without one is still returned, and nothing follows a final newline.
+ */
+class LineScanner {
+    const char *pos;
+    const char *end;
+
+    static const char *findNewline(const char *p, const char *const last) {
+#ifdef LINE_SCANNER_SSE2
+        // Sixteen bytes per compare; the tail is left to memchr
+        const __m128i newline = _mm_set1_epi8('\n');
+        for (; last - p >= 16; p += 16) {
+            const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+            const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+            if (mask != 0) {
+#ifdef _MSC_VER
+                unsigned long first;
+                _BitScanForward(&first, static_cast<unsigned long>(mask));
+                return p + first;
+#else
+                return p + __builtin_ctz(static_cast<unsigned>(mask));
+#endif
+            }
+        }
+#endif
+        const void *found = std::memchr(p, '\n', static_cast<size_t>(last - p));
+        return found != nullptr ? static_cast<const char *>(found) : last;
+    }
+
+public:
+    explicit LineScanner(const std::string_view text) : pos(text.data()), end(text.data() + text.size()) {
+    }
+
+    /**
+     * @brief Reads the next line
+     * @return false once the text is exhausted, like a failed std::getline
+     */
+    bool next(std::string_view &line) {
+        if (pos == end) return false;
+        const char *newline = findNewline(pos, end);
+        line = std::string_view(pos, static_cast<size_t>(newline - pos));
+        pos = newline == end ? end : newline + 1;
+        return true;
+    }
+};
+
+#endif //LINE_SCANNER_H
@@ -1,15 +1,191 @@
 #include "Logger.h"
+#include "LogRing.h"
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <chrono>
+#include <condition_variable>
 #include <iomanip>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 #include <sys/stat.h>
+#ifdef _WIN32
 #include <direct.h>
+#else
+#include <pthread.h>
+#endif
 
-Logger &Logger::getInstance() {
-    static Logger instance;
-    return instance;
+namespace {
+// Logger of the game running on this thread, set by Logger::Scope
+thread_local Logger *bound_logger = nullptr;
+}
+
+/**
+ * One thread per process drains the rings of every logging thread into the files of
+ * the loggers the messages belong to, so a game costs neither a thread nor a ring.
+ * A thread's ring is made on its first message and dropped once the thread exited
+ * and its messages are written.
+ *
+ * The writer is started by the first Logger::init() and never stopped, so loggers
+ * closed during static destruction still find it. A process forked from one with a
+ * writer starts its own, since threads don't survive fork.
+ */
+class Logger::Writer {
+public:
+    static Writer &instance();
+
+    // Ring of the calling thread, registered with the writer on first use
+    LogRing &ring();
+
+    // Wakes the writer if it is napping
+    void wake();
+
+    // Returns once every message queued before the call has been written
+    void flush();
+
+private:
+    struct ThreadRing {
+        LogRing ring;
+        std::atomic<bool> retired{false}; ///< Set when the thread exits; nothing is pushed after
+    };
+
+    // Owner of the calling thread's ring
+    struct RingHandle {
+        Writer *writer = nullptr;
+        std::shared_ptr<ThreadRing> ring;
+
+        ~RingHandle() {
+            if (ring) ring->retired.store(true, std::memory_order_release);
+        }
+    };
+
+    static std::atomic<Writer *> current;
+
+    std::mutex mutex;
+    std::condition_variable wakeup;                 ///< Wakes the writer
+    std::condition_variable flushed;                ///< Wakes the threads waiting in flush()
+    std::vector<std::shared_ptr<ThreadRing>> rings; ///< Guarded by mutex
+    uint64_t flush_requested = 0;                   ///< Guarded by mutex
+    uint64_t flush_done = 0;                        ///< Guarded by mutex
+    std::atomic<bool> idle{false};
+    std::thread thread;
+
+    Writer() : thread(&Writer::run, this) {}
+
+    // Body of the writer thread
+    void run();
+};
+
+std::atomic<Logger::Writer *> Logger::Writer::current{nullptr};
+
+Logger::Writer &Logger::Writer::instance() {
+    Writer *writer = current.load(std::memory_order_acquire);
+    if (writer != nullptr) return *writer;
+
+    static std::mutex start_mutex;
+    std::lock_guard lock(start_mutex);
+    writer = current.load(std::memory_order_relaxed);
+    if (writer == nullptr) {
+#ifndef _WIN32
+        // The child of a fork has no writer thread, so its first logger starts a new writer
+        static const int forked = pthread_atfork(nullptr, nullptr, [] { current.store(nullptr); });
+        (void) forked;
+#endif
+        writer = new Writer();
+        current.store(writer, std::memory_order_release);
+    }
+    return *writer;
+}
+
+LogRing &Logger::Writer::ring() {
+    thread_local RingHandle handle;
+    if (handle.writer != this) {
+        handle.ring = std::make_shared<ThreadRing>();
+        handle.writer = this;
+        std::lock_guard lock(mutex);
+        rings.push_back(handle.ring);
+    }
+    return handle.ring->ring;
+}
+
+void Logger::Writer::wake() {
+    if (idle && idle.exchange(false)) {
+        std::lock_guard lock(mutex);
+        wakeup.notify_one();
+    }
+}
+
+void Logger::Writer::flush() {
+    std::unique_lock lock(mutex);
+    const uint64_t ticket = ++flush_requested;
+    wakeup.notify_one();
+    flushed.wait(lock, [&] { return flush_done >= ticket; });
+}
+
+void Logger::Writer::run() {
+    std::vector<std::shared_ptr<ThreadRing>> draining;
+    std::unordered_map<const void *, std::vector<std::string>> batches;
+    const auto bufferOf = [&batches](const void *owner, const uint8_t stream) -> std::string & {
+        std::vector<std::string> &batch = batches[owner];
+        batch.resize(STREAM_COUNT);
+        return batch[stream];
+    };
+
+    std::unique_lock lock(mutex);
+    while (true) {
+        // A pass that starts after a flush request writes everything queued before it
+        const uint64_t ticket = flush_requested;
+        draining = rings;
+        lock.unlock();
+
+        bool drained = false;
+        for (const auto &thread_ring: draining) {
+            drained |= thread_ring->ring.drainInto(bufferOf);
+        }
+        // A logger waits in close() until its messages are written, so every owner is still alive
+        for (auto &[owner, batch]: batches) {
+            static_cast<Logger *>(const_cast<void *>(owner))->writeBatch(batch);
+        }
+        batches.clear();
+
+        lock.lock();
+        flush_done = ticket;
+        flushed.notify_all();
+        rings.erase(std::remove_if(rings.begin(), rings.end(), [](const std::shared_ptr<ThreadRing> &thread_ring) {
+            return thread_ring->retired.load(std::memory_order_acquire) && thread_ring->ring.empty();
+        }), rings.end());
+        if (drained) continue;
+
+        // Announce the nap before the last look at the rings, so a message pushed meanwhile wakes us
+        idle = true;
+        const bool queued = std::any_of(rings.begin(), rings.end(), [](const std::shared_ptr<ThreadRing> &thread_ring) {
+            return !thread_ring->ring.empty();
+        });
+        if (!queued) {
+            wakeup.wait_for(lock, std::chrono::milliseconds(50), [this] {
+                return !idle || flush_requested != flush_done;
+            });
+        }
+        idle = false;
+    }
+}
+
+Logger::Scope::Scope(Logger &logger) : previous(bound_logger) {
+    bound_logger = &logger;
+}
+
+Logger::Scope::~Scope() {
+    bound_logger = previous;
+}
+
+Logger &Logger::current() {
+    if (bound_logger != nullptr) return *bound_logger;
+    thread_local Logger unbound;
+    return unbound;
 }
 
 Logger::Logger() : initialized(false) {
@@ -20,6 +196,7 @@ Logger::~Logger() {
 }
 
 bool Logger::init(const std::string &path) {
+    muted = false;
     const int last_dot = path.find_last_of(".");
     const int last_slash = path.find_last_of("/");
     std::string name;
@@ -27,13 +204,18 @@ bool Logger::init(const std::string &path) {
     else name = path.substr(last_slash + 1);
 
     // Create log and outputs directories if they don't exist
+#ifdef _WIN32
     _mkdir("logs");
     _mkdir("outputs");
+#else
+    mkdir("logs", 0755);
+    mkdir("outputs", 0755);
+#endif
     
     const std::string out_file_path = "outputs/output_" + name + ".txt";
-    const std::string log_file_path = "logs/log.txt";
-    const std::string err_file_path = "logs/errors.txt";
-    const std::string input_err_file_path = "logs/input_errors.txt";
+    const std::string log_file_path = "logs/log_" + name + ".txt";
+    const std::string err_file_path = "logs/errors_" + name + ".txt";
+    const std::string input_err_file_path = "logs/input_errors_" + name + ".txt";
 
     if (initialized) {
         close();
@@ -48,23 +230,35 @@ bool Logger::init(const std::string &path) {
     log_file.open(log_file_path, std::ios::out);
     if (!log_file.is_open()) {
         std::cerr << "Failed to open log file: " << log_file_path << std::endl;
+        out_file.close();
         return false;
     }
 
     err_file.open(err_file_path, std::ios::out);
     if (!err_file.is_open()) {
         std::cerr << "Failed to open error file: " << err_file_path << std::endl;
+        out_file.close();
         log_file.close();
         return false;
     }
 
     this->input_err_file_path = input_err_file_path;
 
+    Writer::instance();
     initialized = true;
     return true;
 }
 
+void Logger::mute() {
+    close();
+    muted = true;
+}
+
 void Logger::close() {
+    if (initialized) {
+        Writer::instance().flush();
+    }
+
     if (out_file.is_open()) {
         out_file.close();
     }
@@ -77,83 +271,129 @@ void Logger::close() {
         err_file.close();
     }
 
+    if (input_err_file.is_open()) {
+        input_err_file.close();
+    }
+
     initialized = false;
 }
 
+void Logger::push(const Stream stream, const std::string &text) {
+    Writer &writer = Writer::instance();
+    LogRing &ring = writer.ring();
+    for (size_t offset = 0; offset < text.size();) {
+        const auto length = static_cast<uint32_t>(std::min(text.size() - offset, LogRing::MAX_CHUNK));
+        while (!ring.tryPush(this, stream, text.data() + offset, length)) {
+            // The writer is behind; make sure it is awake and give it the core
+            writer.wake();
+            std::this_thread::yield();
+        }
+        offset += length;
+    }
+    writer.wake();
+}
+
+void Logger::writeBatch(std::vector<std::string> &batch) {
+    auto write = [](std::ofstream &file, std::string &text) {
+        if (text.empty()) return;
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        file.flush();
+        text.clear();
+    };
+
+    write(out_file, batch[OUT]);
+    write(log_file, batch[LOG]);
+    write(err_file, batch[ERR]);
+
+    if (batch[INPUT_ERR].empty()) return;
+    if (!input_err_file.is_open()) {
+        input_err_file.open(input_err_file_path, std::ios::out);
+    }
+    if (!input_err_file.is_open()) {
+        std::cerr << "Failed to open input errors file: " << input_err_file_path << std::endl;
+        batch[INPUT_ERR].clear();
+        return;
+    }
+    write(input_err_file, batch[INPUT_ERR]);
+}
+
 void Logger::log(const std::string &message) {
+    if (muted) return;
     if (!initialized) {
         std::cerr << "Logger not initialized, message: " << message << std::endl;
         return;
     }
 
-    log_file << getTimestamp() << " - " << message << std::endl;
-    log_file.flush();
+    push(LOG, getTimestamp() + " - " + message + "\n");
 }
 
-void Logger::logActions(std::vector<std::tuple<bool, ActionRequest, bool, bool> > actions) {
+void Logger::logActions(const std::vector<std::tuple<bool, ActionRequest, bool, bool> > &actions) {
+    if (muted) return;
     if (!initialized) {
         std::cerr << "Logger not initialized" << std::endl;
         return;
     }
 
+    std::string line;
     size_t i = 0;
     for (const auto &[gone, action, result, killed]: actions) {
         if (gone) {
-            out_file << "killed";
-        } else {
-            out_file << action_strings[action];
-            if (!result) out_file << " (ignored)";
-            if (killed) out_file << " (killed)";
-        }
-        
-        if (i++ < actions.size() - 1) {
-            out_file << ", ";
+            line += "killed";
         } else {
-            out_file << std::endl;
+            line += action_strings.at(action);
+            if (!result) line += " (ignored)";
+            if (killed) line += " (killed)";
         }
+
+        line += (i++ < actions.size() - 1) ? ", " : "\n";
     }
 
-    out_file.flush();
+    push(OUT, line);
 }
 
 void Logger::logResult(const std::string &message) {
+    if (muted) return;
     if (!initialized) {
         std::cerr << "Logger not initialized" << std::endl;
         return;
     }
 
-    out_file << message << std::endl;
-    out_file.flush();
+    push(OUT, message + "\n");
 }
 
 void Logger::error(const std::string &message) {
+    if (muted) return;
     if (!initialized) {
         std::cerr << "Logger not initialized, error: " << message << std::endl;
         return;
     }
 
-    err_file << getTimestamp() << ": " << message << std::endl;
-    err_file.flush();
+    push(ERR, getTimestamp() + ": " + message + "\n");
 }
 
 void Logger::inputError(const std::string &message) {
-    if (!input_err_file.is_open()) {
-        input_err_file.open(input_err_file_path, std::ios::out);
-    }
-
-    if (!input_err_file.is_open()) {
-        std::cerr << "Failed to open input errors file: " << input_err_file_path << std::endl;
+    if (muted) return;
+    if (!initialized) {
+        std::cerr << "Logger not initialized, input error: " << message << std::endl;
+        return;
     }
 
-    input_err_file << message << std::endl;
-    input_err_file.flush();
+    push(INPUT_ERR, message + "\n");
 }
 
-std::string Logger::getTimestamp() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
+const std::string &Logger::getTimestamp() {
+    const auto time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    if (time_t == timestamp_second) return timestamp_text;
 
+    std::tm local_time{};
+#ifdef _WIN32
+    localtime_s(&local_time, &time_t);
+#else
+    localtime_r(&time_t, &local_time);
+#endif
     std::stringstream ss;
-    ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
+    ss << std::put_time(&local_time, "%Y-%m-%d %H:%M:%S");
+    timestamp_second = time_t;
+    timestamp_text = ss.str();
+    return timestamp_text;
 }
@@ -0,0 +1,16 @@
+#include "MapTemplate.h"
+
+#include "InputParser.h"
+
+std::shared_ptr<const MapTemplate> MapTemplate::load(const std::string &file_name, Logger &logger) {
+    Logger::Scope logger_scope(logger);
+    InputParser input_parser(logger);
+    std::shared_ptr<MapTemplate> map(new MapTemplate());
+    map->board = input_parser.parseInputFile(file_name);
+    if (map->board == nullptr) return nullptr;
+
+    map->file_name = file_name;
+    map->tanks = input_parser.getTanks();
+    map->map_layout = map->board->getMapLayout();
+    return map;
+}
@@ -0,0 +1,50 @@
+#ifndef MAP_TEMPLATE_H
+#define MAP_TEMPLATE_H
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Board.h"
+#include "Logger.h"
+
+/**
+ * A map file read once and shared by every game played on it.
+ *
+ * The parsed board is never changed after load(). Each game plays on its own
+ * copy made by newBoard(), which copies the grid in bulk instead of reading
+ * and checking the file again, so the cost of parsing is paid once per map
+ * rather than once per game. A template may be shared between threads.
+ */
+class MapTemplate {
+    std::string file_name;
+    std::unique_ptr<Board> board;
+    // (player index, tank index) of every tank on the map, in tank algorithm order
+    std::vector<std::pair<int, int> > tanks;
+    // Walls and mines of the map (see Board::getMapLayout)
+    std::vector<uint8_t> map_layout;
+
+    MapTemplate() = default;
+
+public:
+    /**
+     * @brief Reads a map file
+     *
+     * @param file_name Map file
+     * @param logger Log that receives the input errors of the map
+     * @return nullptr if the file can't be parsed
+     */
+    static std::shared_ptr<const MapTemplate> load(const std::string &file_name, Logger &logger);
+
+    // A board of its own for one game, as if it had just been read from the file
+    std::unique_ptr<Board> newBoard() const { return board->cloneMap(); }
+
+    const std::string &getFileName() const { return file_name; }
+
+    const std::vector<std::pair<int, int> > &getTanks() const { return tanks; }
+
+    const std::vector<uint8_t> &getMapLayout() const { return map_layout; }
+};
+
+#endif //MAP_TEMPLATE_H
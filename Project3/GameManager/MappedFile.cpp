@@ -0,0 +1,58 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MappedFile::open(const std::string &path) {
+    close();
+
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) return false;
+
+    struct stat info{};
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        void *mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            madvise(mapped, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            mapping = mapped;
+            mapping_size = static_cast<size_t>(info.st_size);
+            data = static_cast<const char *>(mapped);
+            size = mapping_size;
+            ::close(fd);
+            return true;
+        }
+    }
+    ::close(fd);
+#endif
+
+    // Text mode, so line endings are translated exactly as for std::getline. A read error
+    // (a directory, say) ends the text where it happens instead of throwing.
+    std::ifstream file(path);
+    if (!file) return false;
+    std::ostringstream text;
+    text << file.rdbuf();
+    const std::string contents = text.str();
+    buffer.assign(contents.begin(), contents.end());
+    data = buffer.data();
+    size = buffer.size();
+    return true;
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+    if (mapping != nullptr) munmap(mapping, mapping_size);
+#endif
+    mapping = nullptr;
+    mapping_size = 0;
+    buffer.clear();
+    data = nullptr;
+    size = 0;
+}
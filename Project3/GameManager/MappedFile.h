@@ -0,0 +1,47 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Read-only view of a whole file.
+ *
+ * On POSIX systems the file is memory-mapped, so its bytes are read in place
+ * without a copy. Elsewhere, or if the file can't be mapped, it is read into a
+ * buffer in text mode, which gives the same lines std::getline would.
+ */
+class MappedFile {
+    const char *data = nullptr;
+    size_t size = 0;
+    void *mapping = nullptr;
+    size_t mapping_size = 0;
+    std::vector<char> buffer;
+
+    void close();
+
+public:
+    MappedFile() = default;
+
+    ~MappedFile() { close(); }
+
+    /**
+     * @brief Opens a file for reading
+     * @return false if the file can't be opened
+     */
+    bool open(const std::string &path);
+
+    [[nodiscard]] std::string_view view() const { return {data, size}; }
+
+    MappedFile(const MappedFile &) = delete;
+
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&) = delete;
+
+    MappedFile &operator=(MappedFile &&) = delete;
+};
+
+#endif //MAPPED_FILE_H
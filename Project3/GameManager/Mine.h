@@ -2,15 +2,20 @@
 #define MINE_H
 
 #include "GameObject.h"
+#include "ObjectPool.h"
 
 class Mine final : public GameObject {
 public:
-    explicit Mine(const Position position): GameObject(position) {
+    static constexpr ObjectKind KIND = ObjectKind::MINE;
+
+    explicit Mine(const Position position): GameObject(KIND, position) {
     }
 
-    [[nodiscard]] char getSymbol() const override { return '@'; }
+    static void *operator new(const size_t size) { return ObjectPool<Mine>::allocate(size); }
 
-    bool isMine() const override { return true; }
+    static void operator delete(void *p, const size_t size) { ObjectPool<Mine>::deallocate(p, size); }
+
+    [[nodiscard]] char getSymbol() const override { return '@'; }
 };
 
 #endif //MINE_H
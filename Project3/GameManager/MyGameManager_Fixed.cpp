@@ -1,4 +1,5 @@
 #include "MyGameManager_Fixed.h"
+#include "MySatelliteView.h"
 #include "../UserCommon/UserCommonTypes.h"
 #include "../UserCommon/UserCommonUtils.h"
 #include <iostream>
@@ -44,29 +45,11 @@ GameResult MyGameManager::run(
         // Simulate interactive game with real Project 2-style visualization using actual algorithms
         return simulateInteractiveGameWithAlgorithms(map, map_width, map_height, max_steps, num_shells);
     } else {
-        // Simple non-visual version
-        displayMap(map, map_width, map_height);
-        simulateGameWithVisualization(map_width, map_height, max_steps);
-        
-        GameResult result;
-        result.winner = 1;
-        result.remaining_tanks = {1, 0};
-        return result;
+        // Same game without the visualization, for simulator runs
+        return playGameWithAlgorithms(map, map_width, map_height, max_steps, num_shells);
     }
 }
 
-void MyGameManager::displayMap(SatelliteView& map, size_t width, size_t height) {
-    std::cout << "\n--- MAP LAYOUT ---" << std::endl;
-    for (size_t row = 0; row < height; ++row) {
-        for (size_t col = 0; col < width; ++col) {
-            char cell = map.getObject(col, row);
-            std::cout << cell;
-        }
-        std::cout << std::endl;
-    }
-    std::cout << "------------------" << std::endl;
-}
-
 void MyGameManager::displayInteractiveMap(SatelliteView& map, size_t width, size_t height) {
     // Print column numbers
     std::cout << "   ";
@@ -108,6 +91,25 @@ std::string MyGameManager::getEmojiForCell(char cell) {
     }
 }
 
+GameResult MyGameManager::playGameWithAlgorithms(SatelliteView& map, size_t width, size_t height, size_t max_steps, size_t num_shells) {
+    GameState state;
+    state.width = width;
+    state.height = height;
+    state.max_steps = max_steps;
+    state.current_step = 0;
+    state.all_shells_exhausted = false;
+    state.post_shell_steps = 0;
+    
+    initializeTanksWithAlgorithms(state, map, width, height, num_shells);
+    
+    while (!isGameOver(state)) {
+        state.current_step++;
+        executeTurnWithAlgorithms(state, map);
+    }
+    
+    return generateFinalResult(state, map);
+}
+
 GameResult MyGameManager::simulateInteractiveGameWithAlgorithms(SatelliteView& map, size_t width, size_t height, size_t max_steps, size_t num_shells) {
     // Create game state
     GameState state;
@@ -153,7 +155,7 @@ GameResult MyGameManager::simulateInteractiveGameWithAlgorithms(SatelliteView& m
     }
     
     // Return final result
-    GameResult result = generateFinalResult(state);
+    GameResult result = generateFinalResult(state, map);
     
     std::cout << "\n=== FINAL RESULT ===" << std::endl;
     std::cout << "Winner: Player " << result.winner << std::endl;
@@ -179,32 +181,6 @@ GameResult MyGameManager::simulateInteractiveGameWithAlgorithms(SatelliteView& m
     return result;
 }
 
-void MyGameManager::simulateGameWithVisualization(size_t /* width */, size_t /* height */, size_t max_steps) {
-    std::cout << "\n--- GAME SIMULATION (showing visualization concept) ---" << std::endl;
-    
-    // Simulate a few game steps to show visualization
-    for (size_t step = 1; step <= std::min(size_t(5), max_steps); ++step) {
-        std::cout << "\nStep " << step << ":" << std::endl;
-        std::cout << "Player 1: Move forward, Tank status: Active" << std::endl;
-        std::cout << "Player 2: Rotate right, Tank status: Active" << std::endl;
-        
-        if (step == 3) {
-            std::cout << "Player 1: FIRE! Shell trajectory: (2,3) -> (4,3)" << std::endl;
-        }
-        
-        if (step == 5) {
-            std::cout << "COLLISION! Player 2 tank destroyed!" << std::endl;
-            break;
-        }
-    }
-    
-    std::cout << "--- End of simulation preview ---" << std::endl;
-    std::cout << "=== GAME COMPLETE ===" << std::endl;
-    std::cout << "Winner: Player 1" << std::endl;
-    std::cout << "Reason: All enemy tanks destroyed" << std::endl;
-    std::cout << "Remaining tanks - Player 1: 1, Player 2: 0" << std::endl;
-}
-
 void MyGameManager::clearScreen() {
     std::cout << "\033[2J\033[1;1H"; // ANSI escape codes to clear screen
 }
@@ -416,11 +392,15 @@ bool MyGameManager::isGameOver(GameState& state) {
             // First time all shells are exhausted - start the 40-step countdown
             state.all_shells_exhausted = true;
             state.post_shell_steps = 0;
-            std::cout << "\n🚨 ALL SHELLS EXHAUSTED! Game continues for 40 more steps...\n";
+            if (verbose_) {
+                std::cout << "\n🚨 ALL SHELLS EXHAUSTED! Game continues for 40 more steps...\n";
+            }
         } else {
             // Already in post-shell phase - increment counter
             state.post_shell_steps++;
-            std::cout << "Post-shell step " << state.post_shell_steps << "/40\n";
+            if (verbose_) {
+                std::cout << "Post-shell step " << state.post_shell_steps << "/40\n";
+            }
             
             // Check if 40 post-shell steps have passed
             if (state.post_shell_steps >= 40) {
@@ -432,8 +412,10 @@ bool MyGameManager::isGameOver(GameState& state) {
     return false;
 }
 
-GameResult MyGameManager::generateFinalResult(const GameState& state) {
+GameResult MyGameManager::generateFinalResult(const GameState& state, SatelliteView& map) {
     GameResult result;
+    result.rounds = state.current_step;
+    result.gameState = createFinalView(state, map, state.width, state.height);
     
     int p1_tanks = 0, p2_tanks = 0;
     for (const auto& tank : state.tanks) {
@@ -452,8 +434,7 @@ GameResult MyGameManager::generateFinalResult(const GameState& state) {
         // Game ended after 40 post-shell steps - it's a TIE
         result.reason = GameResult::ZERO_SHELLS;
         result.winner = 0; // Tie
-        result.remaining_tanks[0] = p1_tanks;
-        result.remaining_tanks[1] = p2_tanks;
+        result.remaining_tanks = {(size_t)p1_tanks, (size_t)p2_tanks};
         return result;
     } else {
         // Check if all players have zero shells (shouldn't happen with new logic)
@@ -493,6 +474,26 @@ GameResult MyGameManager::generateFinalResult(const GameState& state) {
     return result;
 }
 
+std::unique_ptr<SatelliteView> MyGameManager::createFinalView(const GameState& state, SatelliteView& map, size_t width, size_t height) {
+    auto view = std::make_unique<MySatelliteView>(width, height);
+    
+    // Static objects come from the initial map, tanks and shells from the game state
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            char cell = map.getObject(x, y);
+            if (state.current_step > 0 && (cell == '1' || cell == '2')) cell = ' ';
+            view->setObject(x, y, cell);
+        }
+    }
+    for (const auto& shell : state.shells) {
+        if (shell.active) view->setObject(shell.x, shell.y, '*');
+    }
+    for (const auto& tank : state.tanks) {
+        if (tank.alive) view->setObject(tank.x, tank.y, tank.player == 1 ? '1' : '2');
+    }
+    return view;
+}
+
 // Implement helper functions for tank/shell mechanics
 void MyGameManager::moveShell(Shell& shell) {
     const std::vector<std::pair<int, int>> dir_offsets = {
@@ -604,8 +605,10 @@ void MyGameManager::initializeTanksWithAlgorithms(GameState& state, SatelliteVie
                 
                 // Create algorithm instance for player 1
                 if (player1_factory_) {
-                    tank1.algorithm = player1_factory_->create(0, tank_index);
-                    std::cout << "DEBUG: Created algorithm for Player 1 tank " << tank_index << " at (" << x << "," << y << ")\n";
+                    tank1.algorithm = (*player1_factory_)(0, tank_index);
+                    if (verbose_) {
+                        std::cout << "DEBUG: Created algorithm for Player 1 tank " << tank_index << " at (" << x << "," << y << ")\n";
+                    }
                 } else {
                     std::cout << "DEBUG: No factory for Player 1!\n";
                 }
@@ -619,8 +622,10 @@ void MyGameManager::initializeTanksWithAlgorithms(GameState& state, SatelliteVie
                 
                 // Create algorithm instance for player 2
                 if (player2_factory_) {
-                    tank2.algorithm = player2_factory_->create(1, tank_index);
-                    std::cout << "DEBUG: Created algorithm for Player 2 tank " << tank_index << " at (" << x << "," << y << ")\n";
+                    tank2.algorithm = (*player2_factory_)(1, tank_index);
+                    if (verbose_) {
+                        std::cout << "DEBUG: Created algorithm for Player 2 tank " << tank_index << " at (" << x << "," << y << ")\n";
+                    }
                 } else {
                     std::cout << "DEBUG: No factory for Player 2!\n";
                 }
@@ -650,7 +655,9 @@ void MyGameManager::executeTurnWithAlgorithms(GameState& state, SatelliteView& m
     // Execute tank actions using their algorithms
     for (auto& tank : state.tanks) {
         if (tank.alive && tank.algorithm) {
-            std::cout << "DEBUG: Tank Player " << tank.player << " at (" << tank.x << "," << tank.y << ") executing algorithm\n";
+            if (verbose_) {
+                std::cout << "DEBUG: Tank Player " << tank.player << " at (" << tank.x << "," << tank.y << ") executing algorithm\n";
+            }
             
             // Create battle info for the tank
             MyBattleInfo battle_info = createBattleInfo(state, tank, map);
@@ -658,7 +665,9 @@ void MyGameManager::executeTurnWithAlgorithms(GameState& state, SatelliteView& m
             
             // Get action from algorithm
             ActionRequest action = tank.algorithm->getAction();
-            std::cout << "DEBUG: Algorithm returned action: " << static_cast<int>(action) << "\n";
+            if (verbose_) {
+                std::cout << "DEBUG: Algorithm returned action: " << static_cast<int>(action) << "\n";
+            }
             
             // Execute the action
             executeTankActionFromAlgorithm(tank, action, state, map);
@@ -675,7 +684,9 @@ void MyGameManager::executeTurnWithAlgorithms(GameState& state, SatelliteView& m
 
 void MyGameManager::executeTankActionFromAlgorithm(Tank& tank, ActionRequest action, GameState& state, SatelliteView& /* map */) {
     using namespace UserCommon_123456789_987654321;
-    std::cout << "[GameManager] Executing action " << static_cast<int>(action) << " for Player " << tank.player << " at (" << tank.x << "," << tank.y << ")\n";
+    if (verbose_) {
+        std::cout << "[GameManager] Executing action " << static_cast<int>(action) << " for Player " << tank.player << " at (" << tank.x << "," << tank.y << ")\n";
+    }
     switch (action) {
         case ActionRequest::MoveForward:
             moveTank(tank, state);
@@ -69,6 +69,7 @@ private:
     void displayInteractiveMap(SatelliteView& map, size_t width, size_t height);
     std::string getEmojiForCell(char cell);
     GameResult simulateInteractiveGame(SatelliteView& map, size_t width, size_t height, size_t max_steps, size_t num_shells);
+    GameResult playGameWithAlgorithms(SatelliteView& map, size_t width, size_t height, size_t max_steps, size_t num_shells);
     GameResult simulateInteractiveGameWithAlgorithms(SatelliteView& map, size_t width, size_t height, size_t max_steps, size_t num_shells);
     
     // Screen control
@@ -89,7 +90,8 @@ private:
     
     // Game logic helpers
     bool isGameOver(GameState& state);
-    GameResult generateFinalResult(const GameState& state);
+    GameResult generateFinalResult(const GameState& state, SatelliteView& map);
+    std::unique_ptr<SatelliteView> createFinalView(const GameState& state, SatelliteView& map, size_t width, size_t height);
     void moveShell(Shell& shell);
     void checkShellCollisions(Shell& shell, GameState& state);
     void executeTankAction(Tank& tank, int action, GameState& state);
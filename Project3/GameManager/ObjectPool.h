@@ -0,0 +1,124 @@
+#ifndef OBJECT_POOL_H
+#define OBJECT_POOL_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+/**
+ * Free-list allocator for game objects (shells, collisions, mines, walls).
+ *
+ * Memory is carved from fixed-size slabs and recycled through a per-thread
+ * free list, so objects created and destroyed during a game never reach
+ * malloc once the pool is warm. A game runs on a single thread, so when its
+ * board is destroyed every slot goes back to that thread's list and is reused
+ * by the next game. When a thread exits, its free list is handed to a shared
+ * list that refills the next thread running dry, so pools of worker threads
+ * that come and go don't leak. Slabs are kept for the lifetime of the process.
+ *
+ * Used through class-level operator new/delete:
+ *     static void *operator new(size_t size) { return ObjectPool<Shell>::allocate(size); }
+ *     static void operator delete(void *p, size_t size) { ObjectPool<Shell>::deallocate(p, size); }
+ */
+template<typename T>
+class ObjectPool {
+    union Slot {
+        Slot *next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr size_t SLAB_SLOTS = 256;
+
+    // Slabs and the free lists of exited threads; never destroyed, so objects released
+    // during static destruction still have a home
+    struct Shared {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Slot[]> > slabs;
+        std::vector<Slot *> orphans; ///< Free lists left behind by exited threads
+    };
+
+    static Shared &shared() {
+        static auto *pool = new Shared();
+        return *pool;
+    }
+
+    // Free list of the calling thread, handed to the shared pool when the thread exits
+    struct LocalList {
+        Slot *head = nullptr;
+        bool exited = false; ///< Objects released later by other thread_local destructors go to the shared pool
+
+        ~LocalList() {
+            exited = true;
+            if (head == nullptr) return;
+            Shared &pool = shared();
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            pool.orphans.push_back(head);
+            head = nullptr;
+        }
+    };
+
+    static LocalList &localList() {
+        thread_local LocalList list;
+        return list;
+    }
+
+    // A free list an exited thread left behind, or else a new slab; the caller holds the shared mutex
+    static Slot *takeList(Shared &pool) {
+        if (!pool.orphans.empty()) {
+            Slot *list = pool.orphans.back();
+            pool.orphans.pop_back();
+            return list;
+        }
+
+        auto slab = std::make_unique<Slot[]>(SLAB_SLOTS);
+        Slot *first = slab.get();
+        for (size_t i = 0; i + 1 < SLAB_SLOTS; i++) first[i].next = &first[i + 1];
+        first[SLAB_SLOTS - 1].next = nullptr;
+        pool.slabs.push_back(std::move(slab));
+        return first;
+    }
+
+public:
+    static void *allocate(const size_t size) {
+        if (size != sizeof(T)) return ::operator new(size);
+
+        LocalList &list = localList();
+        if (list.head == nullptr || list.exited) {
+            Shared &pool = shared();
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            if (list.exited) {
+                Slot *slot = takeList(pool);
+                if (slot->next != nullptr) pool.orphans.push_back(slot->next);
+                return slot;
+            }
+            list.head = takeList(pool);
+        }
+        Slot *slot = list.head;
+        list.head = slot->next;
+        return slot;
+    }
+
+    static void deallocate(void *p, const size_t size) {
+        if (p == nullptr) return;
+        if (size != sizeof(T)) {
+            ::operator delete(p);
+            return;
+        }
+
+        Slot *slot = static_cast<Slot *>(p);
+        LocalList &list = localList();
+        if (list.exited) {
+            Shared &pool = shared();
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            slot->next = nullptr;
+            pool.orphans.push_back(slot);
+            return;
+        }
+        slot->next = list.head;
+        list.head = slot;
+    }
+};
+
+#endif //OBJECT_POOL_H
@@ -0,0 +1,120 @@
+#ifndef POSITION_INDEX_H
+#define POSITION_INDEX_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Direction.h"
+
+/**
+ * Board position of objects, stored in a table indexed directly by object id.
+ *
+ * forEach visits entries in ascending id order and may be called while the
+ * visitor inserts or erases entries: entries erased during the walk are
+ * skipped, and entries inserted during the walk are not visited until the
+ * next one. This gives the same result as walking a copy of the index without
+ * allocating one.
+ */
+class PositionIndex {
+    struct Entry {
+        Position pos;
+        uint32_t stamp = 0;
+        bool present = false;
+        bool listed = false;
+    };
+
+    std::vector<Entry> entries;
+    // Ascending ids of every listed entry; erased ones are dropped by compact()
+    std::vector<int> order;
+    // Ids inserted during a walk, merged into order once it ends
+    std::vector<int> pending;
+    uint32_t clock = 0;
+    size_t live = 0;
+    int walking = 0;
+
+    void list(const int id) {
+        entries[id].listed = true;
+        if (walking > 0) {
+            pending.push_back(id);
+        } else if (order.empty() || id > order.back()) {
+            order.push_back(id);
+        } else {
+            order.insert(std::lower_bound(order.begin(), order.end(), id), id);
+        }
+    }
+
+    void mergePending() {
+        for (const int id: pending) {
+            order.insert(std::lower_bound(order.begin(), order.end(), id), id);
+        }
+        pending.clear();
+    }
+
+    void compact() {
+        auto it = std::remove_if(order.begin(), order.end(), [this](const int id) {
+            if (entries[id].present) return false;
+            entries[id].listed = false;
+            return true;
+        });
+        order.erase(it, order.end());
+    }
+
+public:
+    void insert(const int id, const Position pos) {
+        if (id < 0) return;
+        if (static_cast<size_t>(id) >= entries.size()) entries.resize(id + 1);
+
+        Entry &entry = entries[id];
+        if (!entry.present) live++;
+        entry.pos = pos;
+        entry.stamp = ++clock;
+        entry.present = true;
+        if (!entry.listed) list(id);
+    }
+
+    void erase(const int id) {
+        if (id < 0 || static_cast<size_t>(id) >= entries.size() || !entries[id].present) return;
+        entries[id].present = false;
+        live--;
+        if (walking == 0 && order.size() > 2 * live + 16) compact();
+    }
+
+    [[nodiscard]] bool empty() const { return live == 0; }
+
+    [[nodiscard]] size_t size() const { return live; }
+
+    template<typename Visitor>
+    void forEach(Visitor &&visit) {
+        const uint32_t start = clock;
+        walking++;
+        // order does not change while walking, so indexing it stays valid
+        for (size_t i = 0; i < order.size(); i++) {
+            const int id = order[i];
+            const Entry entry = entries[id];
+            if (entry.present && entry.stamp <= start) visit(id, entry.pos);
+        }
+        if (--walking == 0) {
+            mergePending();
+            if (order.size() > 2 * live + 16) compact();
+        }
+    }
+
+    template<typename Visitor>
+    void forEach(Visitor &&visit) const {
+        std::vector<int> late = pending;
+        std::sort(late.begin(), late.end());
+        auto next_late = late.begin();
+        auto visitIfPresent = [this, &visit](const int id) {
+            const Entry entry = entries[id];
+            if (entry.present) visit(id, entry.pos);
+        };
+        for (const int id: order) {
+            for (; next_late != late.end() && *next_late < id; ++next_late) visitIfPresent(*next_late);
+            visitIfPresent(id);
+        }
+        for (; next_late != late.end(); ++next_late) visitIfPresent(*next_late);
+    }
+};
+
+#endif //POSITION_INDEX_H
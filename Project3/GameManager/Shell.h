@@ -3,18 +3,23 @@
 
 #include "Direction.h"
 #include "GameObject.h"
+#include "ObjectPool.h"
 
 class Shell final : public GameObject {
     int owner_id;
 
 public:
+    static constexpr ObjectKind KIND = ObjectKind::SHELL;
+
     explicit Shell(const Position position, const Direction::DirectionType direction, const int owner_id): GameObject(
-            position, direction), owner_id(owner_id) {
+            KIND, position, direction), owner_id(owner_id) {
     }
 
-    int getOwnerId() const { return owner_id; }
+    static void *operator new(const size_t size) { return ObjectPool<Shell>::allocate(size); }
 
-    bool isShell() const override { return true; }
+    static void operator delete(void *p, const size_t size) { ObjectPool<Shell>::deallocate(p, size); }
+
+    int getOwnerId() const { return owner_id; }
 
     [[nodiscard]] char getSymbol() const override { return '*'; }
 };
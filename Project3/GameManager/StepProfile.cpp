@@ -0,0 +1,73 @@
+#include "StepProfile.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+uint64_t StepProfile::Histogram::percentile(const double fraction) const {
+    if (count == 0) return 0;
+    const auto rank = static_cast<uint64_t>(fraction * static_cast<double>(count - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t b = 0; b < BUCKETS; b++) {
+        seen += buckets[b];
+        if (seen >= rank) return b == 0 ? 0 : std::min(max, b >= 64 ? UINT64_MAX : (uint64_t{1} << b) - 1);
+    }
+    return max;
+}
+
+double StepProfile::nanosPerTick() const {
+#ifdef STEP_PROFILE_TSC
+    const uint64_t ticks = now() - start_ticks;
+    if (ticks == 0) return 0;
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start_time;
+    return elapsed.count() / static_cast<double>(ticks);
+#else
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::duration(1)).count();
+#endif
+}
+
+const char *StepProfile::phaseName(const Phase phase) {
+    static constexpr const char *names[PHASE_COUNT] = {
+        "step", "satellite_view", "shells_move_1", "finish_move_1", "shells_move_2", "tanks_turn",
+        "finish_move_2", "check_deaths", "log_step", "get_action_1", "get_action_2", "battle_info_1",
+        "battle_info_2",
+    };
+    return names[phase];
+}
+
+std::string StepProfile::format() const {
+    const double ns = nanosPerTick();
+    auto millis = [ns](const uint64_t ticks) { return static_cast<double>(ticks) * ns / 1e6; };
+
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3);
+
+    const uint64_t step = histograms[STEP].total;
+    uint64_t algorithms = 0;
+    for (const Phase phase: {GET_ACTION_1, GET_ACTION_2, BATTLE_INFO_1, BATTLE_INFO_2}) {
+        algorithms += histograms[phase].total;
+    }
+    const uint64_t engine = step > algorithms ? step - algorithms : 0;
+    out << "Profile: " << histograms[STEP].count << " steps, " << millis(step) << " ms, engine "
+        << millis(engine) << " ms, algorithms " << millis(algorithms) << " ms";
+    if (step > 0) out << " (" << std::setprecision(1) << 100.0 * algorithms / step << "% in algorithms)";
+    out << "\n";
+
+    for (size_t p = 0; p < PHASE_COUNT; p++) {
+        const Histogram &histogram = histograms[p];
+        if (histogram.count == 0) continue;
+        out << std::setprecision(3) << phaseName(static_cast<Phase>(p)) << ": calls " << histogram.count
+            << ", total " << millis(histogram.total) << " ms" << std::setprecision(0)
+            << ", mean " << static_cast<double>(histogram.total) * ns / histogram.count << " ns"
+            << ", p50 " << histogram.percentile(0.5) * ns << " ns"
+            << ", p99 " << histogram.percentile(0.99) * ns << " ns"
+            << ", max " << histogram.max * ns << " ns |";
+        for (size_t b = 0; b < BUCKETS; b++) {
+            if (histogram.buckets[b] == 0) continue;
+            const double bound = b >= 64 ? histogram.max * ns : static_cast<double>(uint64_t{1} << b) * ns;
+            out << " " << bound << ":" << histogram.buckets[b];
+        }
+        out << "\n";
+    }
+    return out.str();
+}
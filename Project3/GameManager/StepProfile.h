@@ -0,0 +1,146 @@
+#ifndef STEP_PROFILE_H
+#define STEP_PROFILE_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#if defined(_M_X64) || defined(_M_IX86)
+#define STEP_PROFILE_TSC 1
+#endif
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define STEP_PROFILE_TSC 1
+#endif
+
+// -DTANK_PROFILE=1 times the phases of every step; otherwise PROFILE_SCOPE compiles to nothing
+#ifndef TANK_PROFILE
+#define TANK_PROFILE 0
+#endif
+
+constexpr bool profilingEnabled = TANK_PROFILE != 0;
+
+/**
+ * Where the time of one game goes: a histogram per step phase and per
+ * algorithm call.
+ *
+ * Durations are taken from the time stamp counter, which costs a few cycles
+ * per read, and are converted to nanoseconds only when the profile is
+ * formatted, using the counter rate measured over the game itself. On other
+ * CPUs the steady clock stands in for the counter.
+ */
+class StepProfile {
+public:
+    enum Phase : uint8_t {
+        STEP,            ///< The whole of processStep
+        SATELLITE_VIEW,  ///< updateSatelliteView
+        SHELLS_MOVE_1,   ///< First shellsTurn
+        FINISH_MOVE_1,   ///< finishMove after the shells' first move
+        SHELLS_MOVE_2,   ///< Second shellsTurn
+        TANKS_TURN,      ///< tanksTurn, including the algorithm calls below
+        FINISH_MOVE_2,   ///< finishMove after the tanks' move
+        CHECK_DEATHS,
+        LOG_STEP,
+        GET_ACTION_1,    ///< TankAlgorithm::getAction of player 1's tanks
+        GET_ACTION_2,
+        BATTLE_INFO_1,   ///< Player::updateTankWithBattleInfo of player 1
+        BATTLE_INFO_2,
+        PHASE_COUNT
+    };
+
+    // Bucket b counts durations of fewer than 2^b ticks
+    static constexpr size_t BUCKETS = 65;
+
+    struct Histogram {
+        std::array<uint64_t, BUCKETS> buckets{};
+        uint64_t count = 0;
+        uint64_t total = 0;
+        uint64_t max = 0;
+
+        void add(const uint64_t ticks) {
+            buckets[ticks == 0 ? 0 : 64 - countLeadingZeros(ticks)]++;
+            count++;
+            total += ticks;
+            if (ticks > max) max = ticks;
+        }
+
+        // Upper bound of the bucket holding the given fraction of the durations
+        [[nodiscard]] uint64_t percentile(double fraction) const;
+    };
+
+    static uint64_t now() {
+#ifdef STEP_PROFILE_TSC
+        return __rdtsc();
+#else
+        return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+    // Times its own lifetime into one phase
+    class Scope {
+        StepProfile &profile;
+        const Phase phase;
+        const uint64_t start;
+
+    public:
+        Scope(StepProfile &profile, const Phase phase) : profile(profile), phase(phase), start(now()) {
+        }
+
+        ~Scope() { profile.add(phase, now() - start); }
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+    };
+
+    StepProfile() : start_ticks(now()), start_time(std::chrono::steady_clock::now()) {
+    }
+
+    void add(const Phase phase, const uint64_t ticks) { histograms[phase].add(ticks); }
+
+    [[nodiscard]] const Histogram &get(const Phase phase) const { return histograms[phase]; }
+
+    // Nanoseconds per tick, measured from the creation of the profile until now
+    [[nodiscard]] double nanosPerTick() const;
+
+    /**
+     * @brief Readable report: the split between engine and algorithms, then one line per phase
+     *
+     * Each line gives the number of calls, total, mean, p50, p99 and maximum, followed by the
+     * non-empty histogram buckets as <upper bound in ns>:<count>.
+     */
+    [[nodiscard]] std::string format() const;
+
+    static const char *phaseName(Phase phase);
+
+private:
+    std::array<Histogram, PHASE_COUNT> histograms{};
+    uint64_t start_ticks;
+    std::chrono::steady_clock::time_point start_time;
+
+    static int countLeadingZeros(const uint64_t value) {
+#ifdef _MSC_VER
+        unsigned long index;
+        _BitScanReverse64(&index, value);
+        return 63 - static_cast<int>(index);
+#else
+        return __builtin_clzll(value);
+#endif
+    }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+// Times the rest of the enclosing block into a phase of a StepProfile
+#if TANK_PROFILE
+#define PROFILE_SCOPE(profile, phase) \
+    StepProfile::Scope PROFILE_CONCAT(profile_scope_, __LINE__)((profile), (phase))
+#else
+#define PROFILE_SCOPE(profile, phase) do { } while (false)
+#endif
+
+#endif //STEP_PROFILE_H
@@ -5,7 +5,6 @@
 
 constexpr int MAX_PLAYERS = 9;
 constexpr int COOLDOWN = 4;
-static auto tank_count = std::array<int, MAX_PLAYERS>{};
 
 class Tank final : public GameObject {
     int player_index;
@@ -16,12 +15,15 @@ class Tank final : public GameObject {
     int shell;
 
 public:
-    explicit Tank(Position position, int player_id, int tank_algo_index, size_t shells_count): GameObject(position,
-            player_id == 1
-                ? Direction::LEFT
-                : Direction::RIGHT),
+    static constexpr ObjectKind KIND = ObjectKind::TANK;
+
+    explicit Tank(Position position, int player_id, int tank_index, int tank_algo_index,
+                  size_t shells_count): GameObject(KIND, position,
+                                                   player_id == 1
+                                                       ? Direction::LEFT
+                                                       : Direction::RIGHT),
         player_index(player_id),
-        tank_index(tank_count[player_id]++),
+        tank_index(tank_index),
         tank_algo_index(tank_algo_index),
         shell(shells_count) {
     }
@@ -49,8 +51,6 @@ public:
     void shoot() { shooting_cooldown = COOLDOWN; }
 
     void decrementAmmunition() { if (shell > 0) shell--; }
-
-    bool isTank() const override { return true; }
 };
 
 
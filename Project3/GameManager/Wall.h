@@ -2,6 +2,7 @@
 #define WALL_H
 
 #include "GameObject.h"
+#include "ObjectPool.h"
 
 static constexpr int MAX_HEALTH = 2;
 
@@ -9,12 +10,18 @@ class Wall : public GameObject {
     int health = MAX_HEALTH;
 
 public:
-    explicit Wall(const Position position): GameObject(position) {
+    static constexpr ObjectKind KIND = ObjectKind::WALL;
+
+    explicit Wall(const Position position): GameObject(KIND, position) {
         setObjectType(CellType::WALL);
         // Direction::NONE doesn't exist, use Direction::UP as default
         setDirection(Direction::UP);
     }
 
+    // A map holds walls by the thousand; WeakWall has another size and falls back to the heap
+    static void *operator new(const size_t size) { return ObjectPool<Wall>::allocate(size); }
+    static void operator delete(void *p, const size_t size) { ObjectPool<Wall>::deallocate(p, size); }
+
     [[nodiscard]] char getSymbol() const override { 
         // Return '=' for weakened walls (1 health point left)
         return (health == 1) ? '=' : '#'; 
@@ -32,8 +39,6 @@ public:
 
     void destroy() override { health = 0; }
 
-    [[nodiscard]] bool isWall() const override { return true; }
-    
     [[nodiscard]] bool isDestroyable() const override { return true; }
     [[nodiscard]] bool isCollidable() const override { return true; }
     [[nodiscard]] bool isPassable() const override { return false; }
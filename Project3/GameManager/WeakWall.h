@@ -30,8 +30,6 @@ public:
     }
     
     void destroy() override { health = 0; }
-    
-    [[nodiscard]] bool isWall() const override { return true; }
 };
 
 #endif //WEAK_WALL_H
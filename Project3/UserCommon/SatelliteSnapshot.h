@@ -0,0 +1,75 @@
+#ifndef SATELLITE_SNAPSHOT_H
+#define SATELLITE_SNAPSHOT_H
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "../common/SatelliteView.h"
+
+namespace UserCommon_123456789_987654321 {
+
+/**
+ * Board picture taken once per step by the game manager.
+ * Cells are stored row-major, so a whole row can be read through row(y).
+ */
+class BoardSnapshot {
+    size_t width = 0;
+    size_t height = 0;
+    std::vector<char> cells;
+
+public:
+    BoardSnapshot() = default;
+
+    BoardSnapshot(const size_t width, const size_t height, const char fill = ' ')
+        : width(width), height(height), cells(width * height, fill) {}
+
+    size_t getWidth() const { return width; }
+    size_t getHeight() const { return height; }
+
+    // Pointer to the width() cells of row y
+    const char* row(const size_t y) const { return cells.data() + y * width; }
+    char* row(const size_t y) { return cells.data() + y * width; }
+
+    char get(const size_t x, const size_t y) const { return cells[y * width + x]; }
+    void set(const size_t x, const size_t y, const char c) { cells[y * width + x] = c; }
+
+    bool operator==(const BoardSnapshot& other) const {
+        return width == other.width && height == other.height && cells == other.cells;
+    }
+};
+
+/**
+ * SatelliteView handed to Player::updateTankWithBattleInfo.
+ *
+ * It shares the step's BoardSnapshot instead of copying it, and reports the
+ * requesting tank's own cell as '%'. Algorithms that know this type can take
+ * the snapshot (and keep it alive past the call) instead of reading the board
+ * one virtual getObject call at a time.
+ */
+class SnapshotSatelliteView : public SatelliteView {
+    std::shared_ptr<const BoardSnapshot> snapshot;
+    size_t self_x;
+    size_t self_y;
+
+public:
+    static constexpr char SELF = '%';
+    static constexpr char OUTSIDE = '&';
+
+    SnapshotSatelliteView(std::shared_ptr<const BoardSnapshot> snapshot, const size_t self_x, const size_t self_y)
+        : snapshot(std::move(snapshot)), self_x(self_x), self_y(self_y) {}
+
+    char getObject(const size_t x, const size_t y) const override {
+        if (x >= snapshot->getWidth() || y >= snapshot->getHeight()) return OUTSIDE;
+        if (x == self_x && y == self_y) return SELF;
+        return snapshot->get(x, y);
+    }
+
+    const std::shared_ptr<const BoardSnapshot>& getSnapshot() const { return snapshot; }
+    size_t getSelfX() const { return self_x; }
+    size_t getSelfY() const { return self_y; }
+};
+
+} // namespace UserCommon_123456789_987654321
+
+#endif // SATELLITE_SNAPSHOT_H
@@ -0,0 +1,128 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Board.h"
+#include "Mine.h"
+#include "Shell.h"
+#include "Tank.h"
+#include "Wall.h"
+#include "WeakWall.h"
+
+/**
+ * Micro benchmark for the Board/Collision hot path.
+ *
+ * 1. Classifies a mixed set of objects once with a dynamic_cast chain and once
+ *    with the ObjectKind switch, to show the cost of each dispatch.
+ * 2. Runs shell-heavy half-steps (move every shell, then finishMove) on a
+ *    board with walls and mines and reports the average cost per step.
+ *
+ * Usage: bench_board_step [width] [height] [shells] [steps]
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double elapsedNs(const Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+void benchDispatch() {
+    constexpr size_t OBJECTS = 1 << 20;
+    std::mt19937 rng(7);
+    std::vector<std::unique_ptr<GameObject> > objects;
+    objects.reserve(OBJECTS);
+    for (size_t i = 0; i < OBJECTS; i++) {
+        const Position pos(static_cast<int>(i % 64), static_cast<int>(i / 64 % 64));
+        switch (rng() % 4) {
+            case 0: objects.push_back(std::make_unique<Wall>(pos)); break;
+            case 1: objects.push_back(std::make_unique<Mine>(pos)); break;
+            case 2: objects.push_back(std::make_unique<Shell>(pos, Direction::UP, 0)); break;
+            default: objects.push_back(std::make_unique<Tank>(pos, 1, 0, 0, 0)); break;
+        }
+    }
+
+    size_t counts[4] = {};
+    auto start = Clock::now();
+    for (const auto &object: objects) {
+        if (dynamic_cast<Tank *>(object.get())) counts[0]++;
+        else if (dynamic_cast<Shell *>(object.get())) counts[1]++;
+        else if (dynamic_cast<Mine *>(object.get())) counts[2]++;
+        else if (dynamic_cast<Wall *>(object.get())) counts[3]++;
+    }
+    const double cast_ns = elapsedNs(start) / OBJECTS;
+
+    start = Clock::now();
+    for (const auto &object: objects) {
+        switch (object->getKind()) {
+            case ObjectKind::TANK: counts[0]--; break;
+            case ObjectKind::SHELL: counts[1]--; break;
+            case ObjectKind::MINE: counts[2]--; break;
+            case ObjectKind::WALL: counts[3]--; break;
+            case ObjectKind::COLLISION: break;
+        }
+    }
+    const double kind_ns = elapsedNs(start) / OBJECTS;
+
+    if (counts[0] || counts[1] || counts[2] || counts[3]) {
+        std::cerr << "Error: dispatch mismatch" << std::endl;
+    }
+    std::cout << "dispatch: dynamic_cast chain " << cast_ns << " ns/object, kind switch " << kind_ns
+              << " ns/object" << std::endl;
+}
+
+void benchBoardStep(const int width, const int height, const size_t shells, const size_t steps) {
+    std::mt19937 rng(11);
+    Board board("bench", steps, 0, width, height);
+
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const unsigned roll = rng() % 100;
+            if (roll < 4) board.placeObject(std::make_unique<Wall>(Position(x, y)));
+            else if (roll < 6) board.placeObject(std::make_unique<WeakWall>(Position(x, y)));
+            else if (roll < 7) board.placeObject(std::make_unique<Mine>(Position(x, y)));
+        }
+    }
+
+    auto refill = [&]() {
+        size_t live = board.getShells().size();
+        for (size_t tries = 0; live < shells && tries < shells * 4; tries++) {
+            const Position pos(static_cast<int>(rng() % width), static_cast<int>(rng() % height));
+            if (board.isOccupied(pos)) continue;
+            board.placeObject(std::make_unique<Shell>(pos, Direction::getDirection(rng() % 8 * 45), 0));
+            live++;
+        }
+    };
+
+    refill();
+    double total_ns = 0;
+    for (size_t step = 0; step < steps; step++) {
+        const auto start = Clock::now();
+        for (const auto &[id, shell]: board.getShells()) {
+            board.moveObject(shell->getPosition(), shell->getDirection());
+        }
+        board.finishMove();
+        total_ns += elapsedNs(start);
+        refill();
+    }
+
+    std::cout << "board " << width << "x" << height << ", " << shells << " shells: "
+              << total_ns / steps / 1000.0 << " us/half-step" << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    const int width = argc > 1 ? std::atoi(argv[1]) : 200;
+    const int height = argc > 2 ? std::atoi(argv[2]) : 200;
+    const size_t shells = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 500;
+    const size_t steps = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 2000;
+
+    benchDispatch();
+    benchBoardStep(width, height, shells, steps);
+    return 0;
+}
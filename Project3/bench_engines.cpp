@@ -0,0 +1,384 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "common/Player.h"
+#include "common/SatelliteView.h"
+#include "common/TankAlgorithm.h"
+
+// The engines share class names, so every build of this file measures exactly one of them
+#if defined(BENCH_ENGINE_GAME_MANAGER)
+#include "GameManager/GameManager.h"
+#elif defined(BENCH_ENGINE_FIXED)
+#include "GameManager/MyGameManager_Fixed.h"
+#elif defined(BENCH_ENGINE_SRC)
+#include "src/GameManager.h"
+#else
+#error "Define BENCH_ENGINE_GAME_MANAGER, BENCH_ENGINE_FIXED or BENCH_ENGINE_SRC"
+#endif
+
+/**
+ * Throughput benchmark for one game engine on synthetic maps.
+ *
+ * Every combination of map size and tank count is played once with the same
+ * scripted tanks, so the time goes to the engine rather than to an algorithm.
+ * Each game runs in a child process of its own: peak RSS is that game's, and
+ * whatever the engine prints goes to /dev/null. Results are written to stdout
+ * as one JSON object per engine (`make bench` merges the three).
+ *
+ * Usage: bench_engine [-sizes WxH,...] [-tanks n,...] [-walls density] [-mines density]
+ *                     [-steps n] [-shells n] [-seed n]
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Scenario {
+    size_t width = 0;
+    size_t height = 0;
+    size_t tanks = 0;
+    double wall_density = 0.2;
+    double mine_density = 0.05;
+    size_t max_steps = 200;
+    size_t num_shells = 20;
+    uint32_t seed = 1;
+};
+
+struct Measurement {
+    size_t steps = 0;
+    size_t tank_actions = 0;
+    double seconds = 0;
+    long peak_rss_kb = 0;
+    std::string error;
+};
+
+#if defined(BENCH_ENGINE_GAME_MANAGER)
+constexpr const char *ENGINE_NAME = "GameManager/GameManager.cpp";
+constexpr size_t MAX_TANKS_PER_PLAYER = SIZE_MAX;
+#elif defined(BENCH_ENGINE_FIXED)
+constexpr const char *ENGINE_NAME = "GameManager/MyGameManager_Fixed.cpp";
+constexpr size_t MAX_TANKS_PER_PLAYER = SIZE_MAX;
+#else
+constexpr const char *ENGINE_NAME = "src/GameManager.cpp";
+// initializeGameFromMap rejects a map with a second tank for a player
+constexpr size_t MAX_TANKS_PER_PLAYER = 1;
+#endif
+
+// Tank actions requested by the engine in this process
+size_t tank_actions = 0;
+
+// Walls, mines and tanks spread at random, player 1 on the left half and player 2 on the right
+class SyntheticMap final : public SatelliteView {
+    size_t width;
+    size_t height;
+    std::vector<char> cells;
+
+public:
+    explicit SyntheticMap(const Scenario &scenario) : width(scenario.width), height(scenario.height),
+                                                      cells(scenario.width * scenario.height, ' ') {
+        std::mt19937 rng(scenario.seed);
+        std::uniform_real_distribution<double> roll(0.0, 1.0);
+        for (char &cell: cells) {
+            const double r = roll(rng);
+            if (r < scenario.wall_density) cell = r < scenario.wall_density * 0.75 ? '#' : '=';
+            else if (r < scenario.wall_density + scenario.mine_density) cell = '@';
+        }
+
+        const size_t half = std::max<size_t>(width / 2, 1);
+        for (size_t i = 0; i < scenario.tanks; i++) {
+            const int player = i % 2 == 0 ? 1 : 2;
+            const size_t x_from = player == 1 ? 0 : width - half;
+            // Give up on a tank that finds no free cell in a reasonable number of tries
+            for (int attempt = 0; attempt < 64; attempt++) {
+                const size_t x = x_from + rng() % half;
+                const size_t y = rng() % height;
+                char &cell = cells[y * width + x];
+                if (cell == '1' || cell == '2') continue;
+                cell = static_cast<char>('0' + player);
+                break;
+            }
+        }
+    }
+
+    char getObject(const size_t x, const size_t y) const override {
+        if (x >= width || y >= height) return '&';
+        return cells[y * width + x];
+    }
+
+    void write(const std::string &path, const Scenario &scenario) const {
+        std::ofstream out(path);
+        out << "bench " << width << "x" << height << "\n"
+                << "MaxSteps = " << scenario.max_steps << "\n"
+                << "NumShells = " << scenario.num_shells << "\n"
+                << "Rows = " << height << "\n"
+                << "Cols = " << width << "\n";
+        for (size_t y = 0; y < height; y++) {
+            out.write(&cells[y * width], static_cast<std::streamsize>(width));
+            out << "\n";
+        }
+    }
+};
+
+class BenchBattleInfo final : public BattleInfo {
+};
+
+class BenchPlayer final : public Player {
+public:
+    using Player::Player;
+
+    void updateTankWithBattleInfo(TankAlgorithm &tank, SatelliteView &) override {
+        BenchBattleInfo info;
+        tank.updateBattleInfo(info);
+    }
+};
+
+// Cheap, repeatable actions: mostly moving and turning, with some shots and battle info requests
+class BenchTankAlgorithm final : public TankAlgorithm {
+    uint32_t state;
+
+public:
+    BenchTankAlgorithm(const int player_index, const int tank_index)
+        : state(static_cast<uint32_t>(player_index) * 7919u + static_cast<uint32_t>(tank_index) * 104729u + 1u) {
+    }
+
+    ActionRequest getAction() override {
+        static constexpr ActionRequest actions[] = {
+            ActionRequest::MoveForward, ActionRequest::MoveForward, ActionRequest::MoveForward,
+            ActionRequest::MoveForward, ActionRequest::MoveBackward, ActionRequest::RotateLeft90,
+            ActionRequest::RotateRight90, ActionRequest::RotateLeft45, ActionRequest::RotateRight45,
+            ActionRequest::Shoot, ActionRequest::Shoot, ActionRequest::Shoot,
+            ActionRequest::GetBattleInfo, ActionRequest::GetBattleInfo, ActionRequest::DoNothing,
+            ActionRequest::DoNothing,
+        };
+        tank_actions++;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return actions[state % 16];
+    }
+
+    void updateBattleInfo(BattleInfo &) override {
+    }
+};
+
+PlayerFactory player_factory = [](const int player_index, const size_t x, const size_t y, const size_t max_steps,
+                                  const size_t num_shells) {
+    return std::make_unique<BenchPlayer>(player_index, x, y, max_steps, num_shells);
+};
+
+TankAlgorithmFactory tank_algorithm_factory = [](const int player_index, const int tank_index) {
+    return std::make_unique<BenchTankAlgorithm>(player_index, tank_index);
+};
+
+// Plays one game and returns the number of steps it took
+size_t playGame(const Scenario &scenario, SyntheticMap &map, Measurement &measurement) {
+#if defined(BENCH_ENGINE_GAME_MANAGER)
+    // This engine reads its map from a file; reading it is part of the game
+    const std::string path = (std::filesystem::temp_directory_path() /
+                              ("tank_bench_" + std::to_string(getpid()) + ".txt")).string();
+    map.write(path, scenario);
+
+    const auto start = Clock::now();
+    GameManager game(player_factory, tank_algorithm_factory);
+    game.setLogging(false);
+    game.readBoard(path);
+    game.run();
+    measurement.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    std::filesystem::remove(path);
+    return game.getStep();
+#else
+    TankAlgorithmFactory factory1 = tank_algorithm_factory;
+    TankAlgorithmFactory factory2 = tank_algorithm_factory;
+    const auto player1 = player_factory(1, scenario.width, scenario.height, scenario.max_steps, scenario.num_shells);
+    const auto player2 = player_factory(2, scenario.width, scenario.height, scenario.max_steps, scenario.num_shells);
+
+    const auto start = Clock::now();
+#if defined(BENCH_ENGINE_FIXED)
+    GameManager_123456789_987654321::MyGameManager game(false);
+#else
+    GameManager game(false);
+#endif
+    const GameResult result = game.run(scenario.width, scenario.height, map, scenario.max_steps,
+                                       scenario.num_shells, *player1, *player2, factory1, factory2);
+    measurement.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    return result.rounds;
+#endif
+}
+
+Measurement measure(const Scenario &scenario) {
+    Measurement measurement;
+    SyntheticMap map(scenario);
+    tank_actions = 0;
+    measurement.steps = playGame(scenario, map, measurement);
+    measurement.tank_actions = tank_actions;
+#ifndef _WIN32
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    measurement.peak_rss_kb = usage.ru_maxrss;
+#endif
+    return measurement;
+}
+
+std::string toJson(const Scenario &scenario, const Measurement &measurement) {
+    std::ostringstream out;
+    out << "{\"width\": " << scenario.width << ", \"height\": " << scenario.height
+            << ", \"tanks\": " << scenario.tanks << ", \"wall_density\": " << scenario.wall_density
+            << ", \"mine_density\": " << scenario.mine_density << ", \"max_steps\": " << scenario.max_steps
+            << ", \"num_shells\": " << scenario.num_shells << ", \"seed\": " << scenario.seed;
+    if (!measurement.error.empty()) {
+        out << ", \"error\": \"" << measurement.error << "\"}";
+        return out.str();
+    }
+    const double steps_per_sec = measurement.seconds > 0 ? measurement.steps / measurement.seconds : 0;
+    const double ns_per_action = measurement.tank_actions > 0
+                                     ? measurement.seconds * 1e9 / measurement.tank_actions
+                                     : 0;
+    out << ", \"steps\": " << measurement.steps << ", \"tank_actions\": " << measurement.tank_actions
+            << ", \"seconds\": " << measurement.seconds << ", \"steps_per_sec\": " << steps_per_sec
+            << ", \"ns_per_tank_action\": " << ns_per_action << ", \"peak_rss_kb\": " << measurement.peak_rss_kb
+            << "}";
+    return out.str();
+}
+
+/**
+ * @brief Runs one scenario in a child process and returns its JSON result
+ *
+ * The child sends the result back through a pipe; a child that dies is reported as an error.
+ */
+std::string runScenario(const Scenario &scenario) {
+#ifdef _WIN32
+    return toJson(scenario, measure(scenario));
+#else
+    int fds[2];
+    if (pipe(fds) != 0) return toJson(scenario, measure(scenario));
+
+    std::cout.flush();
+    const pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return toJson(scenario, measure(scenario));
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        const int null_fd = open("/dev/null", O_RDWR);
+        dup2(null_fd, STDIN_FILENO);
+        dup2(null_fd, STDOUT_FILENO);
+        const std::string json = toJson(scenario, measure(scenario));
+        const ssize_t written = write(fds[1], json.data(), json.size());
+        _exit(written == static_cast<ssize_t>(json.size()) ? 0 : 1);
+    }
+    close(fds[1]);
+
+    std::string json;
+    char buffer[4096];
+    ssize_t count;
+    while ((count = read(fds[0], buffer, sizeof(buffer))) > 0) json.append(buffer, static_cast<size_t>(count));
+    close(fds[0]);
+
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || json.empty()) {
+        Measurement failed;
+        failed.error = WIFSIGNALED(status)
+                           ? "killed by signal " + std::to_string(WTERMSIG(status))
+                           : "benchmark process failed";
+        return toJson(scenario, failed);
+    }
+    return json;
+#endif
+}
+
+std::vector<std::string> splitList(const std::string &list) {
+    std::vector<std::string> items;
+    std::stringstream in(list);
+    std::string item;
+    while (std::getline(in, item, ',')) {
+        if (!item.empty()) items.push_back(item);
+    }
+    return items;
+}
+
+} // namespace
+
+int main(const int argc, char *argv[]) {
+    std::vector<std::pair<size_t, size_t> > sizes = {{10, 10}, {100, 100}, {500, 500}, {2000, 2000}};
+    std::vector<size_t> tank_counts = {2, 20, 500};
+    Scenario base;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string option = argv[i];
+        const std::string value = argv[i + 1];
+        if (option == "-sizes") {
+            sizes.clear();
+            for (const std::string &size: splitList(value)) {
+                size_t width = 0, height = 0;
+                if (std::sscanf(size.c_str(), "%zux%zu", &width, &height) == 2 && width > 0 && height > 0) {
+                    sizes.emplace_back(width, height);
+                }
+            }
+        } else if (option == "-tanks") {
+            tank_counts.clear();
+            for (const std::string &count: splitList(value)) tank_counts.push_back(std::strtoul(count.c_str(), nullptr, 10));
+        } else if (option == "-walls") {
+            base.wall_density = std::strtod(value.c_str(), nullptr);
+        } else if (option == "-mines") {
+            base.mine_density = std::strtod(value.c_str(), nullptr);
+        } else if (option == "-steps") {
+            base.max_steps = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (option == "-shells") {
+            base.num_shells = std::strtoul(value.c_str(), nullptr, 10);
+        } else if (option == "-seed") {
+            base.seed = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else {
+            std::cerr << "Unknown argument: " << option << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::cout << "{\"engine\": \"" << ENGINE_NAME << "\", \"results\": [";
+    bool first = true;
+    for (const auto &[width, height]: sizes) {
+        for (const size_t tanks: tank_counts) {
+            Scenario scenario = base;
+            scenario.width = width;
+            scenario.height = height;
+            scenario.tanks = tanks;
+
+            std::string json;
+            if (tanks < 2 || tanks > 2 * MAX_TANKS_PER_PLAYER || tanks > width * height / 2) {
+                // Reported rather than left out, so every engine lists the same scenarios
+                Measurement skipped;
+                skipped.error = tanks > 2 * MAX_TANKS_PER_PLAYER
+                                    ? "engine supports " + std::to_string(MAX_TANKS_PER_PLAYER) + " tank per player"
+                                    : "tank count does not fit the map";
+                json = toJson(scenario, skipped);
+            } else {
+                std::cerr << ENGINE_NAME << ": " << width << "x" << height << ", " << tanks << " tanks" << std::endl;
+                json = runScenario(scenario);
+            }
+            std::cout << (first ? "\n  " : ",\n  ") << json;
+            first = false;
+        }
+    }
+    std::cout << "\n]}" << std::endl;
+    return EXIT_SUCCESS;
+}
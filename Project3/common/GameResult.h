@@ -3,6 +3,9 @@
 
 #include <vector>
 #include <cstddef>
+#include <memory>
+
+#include "SatelliteView.h"
 
 /**
  * Structure containing the results of a completed game
@@ -12,7 +15,7 @@ struct GameResult {
      * Winner of the game
      * 0 = tie, 1 = player 1, 2 = player 2
      */
-    int winner;
+    int winner = 0;
     
     /**
      * Reason the game ended
@@ -22,13 +25,23 @@ struct GameResult {
         MAX_STEPS,       // Maximum number of steps reached
         ZERO_SHELLS      // All players out of ammunition
     };
-    Reason reason;
+    Reason reason = MAX_STEPS;
     
     /**
      * Number of remaining tanks per player
      * Index 0 = player 1, index 1 = player 2
      */
     std::vector<size_t> remaining_tanks;
+    
+    /**
+     * Snapshot of the board at the end of the game
+     */
+    std::unique_ptr<SatelliteView> gameState;
+    
+    /**
+     * Total number of rounds played
+     */
+    size_t rounds = 0;
 };
 
 #endif // GAME_RESULT_H
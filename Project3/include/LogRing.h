@@ -0,0 +1,104 @@
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+/**
+ * @file LogRing.h
+ * @brief Lock-free single-producer single-consumer byte ring used by Logger
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Bounded byte ring between one logging thread and the log writer
+ *
+ * Messages are stored as records of [owner:8][stream:1][length:4][bytes], where
+ * owner identifies the logger the message belongs to, since one thread may log
+ * for several games in turn. A message longer than MAX_CHUNK is split into
+ * several records of the same stream, which the writer simply concatenates.
+ * head and tail only ever grow; their difference is the number of bytes in use.
+ */
+class LogRing {
+public:
+    static constexpr size_t CAPACITY = size_t{1} << 20;
+    static constexpr size_t MAX_CHUNK = CAPACITY / 8;
+
+    LogRing() : bytes(CAPACITY) {}
+
+    /**
+     * @brief Appends one chunk if it fits
+     * @return false if the ring is too full right now
+     */
+    bool tryPush(const void *owner, const uint8_t stream, const char *data, const uint32_t length) {
+        const size_t record = HEADER + length;
+        const size_t tail_now = tail.load(std::memory_order_relaxed);
+        if (CAPACITY - (tail_now - head.load(std::memory_order_acquire)) < record) return false;
+
+        char header[HEADER];
+        std::memcpy(header, &owner, sizeof(owner));
+        header[sizeof(owner)] = static_cast<char>(stream);
+        std::memcpy(header + sizeof(owner) + 1, &length, sizeof(length));
+        copyIn(tail_now, header, HEADER);
+        copyIn(tail_now + HEADER, data, length);
+        tail.store(tail_now + record, std::memory_order_seq_cst);
+        return true;
+    }
+
+    [[nodiscard]] bool empty() const {
+        return head.load(std::memory_order_relaxed) == tail.load(std::memory_order_seq_cst);
+    }
+
+    /**
+     * @brief Moves every complete record into the buffer bufferOf(owner, stream) returns for it
+     * @return true if anything was read
+     */
+    template <typename BufferOf>
+    bool drainInto(BufferOf &&bufferOf) {
+        const size_t end = tail.load(std::memory_order_acquire);
+        size_t pos = head.load(std::memory_order_relaxed);
+        if (pos == end) return false;
+
+        while (pos < end) {
+            char header[HEADER];
+            copyOut(pos, header, HEADER);
+            const void *owner;
+            std::memcpy(&owner, header, sizeof(owner));
+            uint32_t length;
+            std::memcpy(&length, header + sizeof(owner) + 1, sizeof(length));
+            std::string &out = bufferOf(owner, static_cast<uint8_t>(header[sizeof(owner)]));
+            const size_t old_size = out.size();
+            out.resize(old_size + length);
+            copyOut(pos + HEADER, out.data() + old_size, length);
+            pos += HEADER + length;
+        }
+        head.store(pos, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr size_t HEADER = sizeof(void *) + 1 + sizeof(uint32_t);
+
+    std::vector<char> bytes;
+    alignas(64) std::atomic<size_t> head{0}; ///< Next byte the writer reads
+    alignas(64) std::atomic<size_t> tail{0}; ///< Next byte the game writes
+
+    void copyIn(const size_t at, const char *data, const size_t length) {
+        const size_t offset = at % CAPACITY;
+        const size_t first = std::min(length, CAPACITY - offset);
+        std::memcpy(bytes.data() + offset, data, first);
+        std::memcpy(bytes.data(), data + first, length - first);
+    }
+
+    void copyOut(const size_t at, char *data, const size_t length) const {
+        const size_t offset = at % CAPACITY;
+        const size_t first = std::min(length, CAPACITY - offset);
+        std::memcpy(data, bytes.data() + offset, first);
+        std::memcpy(data + first, bytes.data(), length - first);
+    }
+};
+
+#endif // LOG_RING_H
@@ -5,10 +5,16 @@
  * @file Logger.h
  * @brief Logging facility for the tank game
  * 
- * Provides a singleton logger that handles different types of log messages
+ * Provides a per-game logger that handles different types of log messages
  * and writes them to appropriate files.
+ *
+ * Messages are handed to one process-wide background writer through a lock-free
+ * ring of the logging thread, and the writer appends them to the games' files in
+ * batches. Diagnostic messages go through the LOG_DEBUG/LOG_INFO/LOG_ERROR macros,
+ * which compile to nothing below TANK_LOG_LEVEL (the message is not even built).
  */
 
+#include <ctime>
 #include <fstream>
 #include <map>
 #include <string>
@@ -17,18 +23,71 @@
 #include "ActionRequest.h"
 
 /**
- * @brief Singleton logger class for the tank game
+ * @brief Severity of a diagnostic message
+ */
+enum class LogLevel {
+    Debug = 0, ///< Per-action chatter of algorithms
+    Info = 1,  ///< Game setup and progress
+    Error = 2, ///< Runtime errors
+    Off = 3,   ///< No diagnostics at all
+};
+
+// Lowest level that is compiled in: -DTANK_LOG_LEVEL=0 keeps debug messages, 3 drops every diagnostic
+#ifndef TANK_LOG_LEVEL
+#define TANK_LOG_LEVEL 1
+#endif
+
+constexpr bool isLogLevelEnabled(const LogLevel level) {
+    return static_cast<int>(level) >= TANK_LOG_LEVEL;
+}
+
+/**
+ * @brief Logger of one game
  * 
  * Implements logging functionality with different output streams
  * for regular logs, errors, and action tracking.
+ *
+ * Each game manager owns its logger, so games running on different threads
+ * never share one. Code that is not handed the logger (tank algorithms and
+ * players) reaches it through current(), which returns the logger bound to
+ * the calling thread by a Scope.
+ *
+ * Messages of one thread are written in order; a logger used by several
+ * threads at once may see their messages interleaved by batch.
  */
 class Logger {
 public:
     /**
-     * @brief Access the single instance of the Logger
-     * @return Reference to the singleton Logger instance
+     * @brief Binds a logger to the calling thread for the lifetime of the scope
+     *
+     * Scopes nest; the previous binding is restored when the scope ends.
+     */
+    class Scope {
+    public:
+        explicit Scope(Logger &logger);
+
+        ~Scope();
+
+        Scope(const Scope &) = delete;
+
+        Scope &operator=(const Scope &) = delete;
+
+    private:
+        Logger *previous;
+    };
+
+    Logger();
+
+    /**
+     * @brief Destructor - ensures proper cleanup of file resources
+     */
+    ~Logger();
+
+    /**
+     * @brief Logger of the game running on the calling thread
+     * @return The logger bound by the innermost Scope, or an uninitialized logger of this thread if there is none
      */
-    static Logger &getInstance();
+    static Logger &current();
 
     /**
      * @brief Write a message to the main log file
@@ -40,7 +99,7 @@ public:
      * @brief Log tank actions with their outcomes
      * @param actions Vector of tuples containing (isPlayer1, ActionRequest, isSuccessful, isValid)
      */
-    void logActions(std::vector<std::tuple<bool, ActionRequest, bool, bool> > actions);
+    void logActions(const std::vector<std::tuple<bool, ActionRequest, bool, bool> > &actions);
 
     /**
      * @brief Log game result information
@@ -60,50 +119,91 @@ public:
      */
     void inputError(const std::string &message);
 
-    // Initialize with custom file paths
+    /**
+     * @brief Opens the sinks of the game played on the given map, starting the process's writer if needed
+     *
+     * The game's output goes to outputs/output_<name>.txt and its diagnostics to
+     * logs/log_<name>.txt, logs/errors_<name>.txt and logs/input_errors_<name>.txt,
+     * where name is the map file name without directory and extension.
+     *
+     * @param path Path of the map file
+     * @return false if a file could not be opened
+     */
     bool init(const std::string &path);
 
-    // Close log files
+    // Waits until everything queued for this logger is written and closes the files
     void close();
 
-    // Delete copy and assignment to ensure singleton pattern
+    // Drops every message from now on, without any file or complaint, until the next init()
+    void mute();
+
+    // The logger owns its files, so it is neither copied nor moved
     Logger(const Logger &) = delete;
 
     Logger &operator=(const Logger &) = delete;
 
-    // Delete move and assignment to ensure singleton pattern
     Logger(Logger &&) = delete;
 
     Logger &operator=(Logger &&) = delete;
 
 private:
-    /**
-     * @brief Private constructor - enforces singleton pattern
-     */
-    Logger();
+    // Process-wide thread draining the rings of every logging thread, defined in Logger.cpp
+    class Writer;
+
+    // File a queued message belongs to
+    enum Stream : uint8_t {
+        OUT,
+        LOG,
+        ERR,
+        INPUT_ERR,
+        STREAM_COUNT
+    };
 
     /**
-     * @brief Destructor - ensures proper cleanup of file resources
+     * @brief Generate timestamp for log entry prefixes
+     *
+     * The text is only formatted again when the second changes.
+     *
+     * @return Formatted timestamp string
      */
-    ~Logger();
+    const std::string &getTimestamp();
 
     /**
-     * @brief Generate timestamp for log entry prefixes
-     * @return Formatted timestamp string
+     * @brief Queues text for a stream in the calling thread's ring, waiting for the writer if it is full
      */
-    std::string getTimestamp() const;
+    void push(Stream stream, const std::string &text);
 
-    // Output streams for different log types
+    // Appends one batch to the files; the input errors file is only created once it has content
+    void writeBatch(std::vector<std::string> &batch);
+
+    // Output streams for different log types, only touched by the writer thread while the logger is open
     std::ofstream out_file;       ///< Output file stream for general game output
     std::ofstream log_file;       ///< Log file stream for diagnostic information
     std::ofstream err_file;       ///< Error file stream for runtime errors
     std::string input_err_file_path;  ///< Path to input error log file
     std::ofstream input_err_file;  ///< Input error file stream for parsing errors
 
+    std::time_t timestamp_second{-1};
+    std::string timestamp_text;
+
     // Initialization status
     bool initialized;
+    bool muted = false;
 };
 
+// Diagnostic logging; the message expression is only evaluated when the level is compiled in
+#define LOG_AT_LEVEL(level, logger, message) \
+    do { \
+        if constexpr (isLogLevelEnabled(level)) (logger).log(message); \
+    } while (false)
+
+#define LOG_DEBUG(logger, message) LOG_AT_LEVEL(LogLevel::Debug, logger, message)
+#define LOG_INFO(logger, message) LOG_AT_LEVEL(LogLevel::Info, logger, message)
+#define LOG_ERROR(logger, message) \
+    do { \
+        if constexpr (isLogLevelEnabled(LogLevel::Error)) (logger).error(message); \
+    } while (false)
+
 
 /**
  * @brief Mapping from action enum to human-readable strings
@@ -111,7 +211,7 @@ private:
  * Used for logging and display purposes to convert action codes
  * to meaningful text descriptions.
  */
-inline std::map<ActionRequest, std::string> action_strings = {
+inline const std::map<ActionRequest, std::string> action_strings = {
     // No movement action
     {ActionRequest::DoNothing, "None"},
     
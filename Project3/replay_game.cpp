@@ -0,0 +1,222 @@
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "GameManager.h"
+#include "GameRecord.h"
+#include "MapTemplate.h"
+#include "Player.h"
+#include "TankAlgorithm.h"
+#include "../UserCommon/SatelliteSnapshot.h"
+
+/**
+ * Replays a binary game record written by GameManager::setRecordFile.
+ *
+ * The game is played again on its map with every tank taking its recorded
+ * action, starting from the last keyframe before the requested step.
+ *
+ * 1. Without options, prints the record header and the board after the last step.
+ * 2. -step <n> prints the board after step n instead.
+ * 3. -verify replays the whole game, compares the state at every keyframe and
+ *    the result with the record, and exits with 1 on the first difference.
+ *
+ * Usage: replay_game <record-file> [-map <map-file>] [-step <n>] [-verify]
+ */
+
+namespace {
+
+// Step being replayed, read by the tank algorithms of the replayed game
+struct ReplayClock {
+    const GameRecordReader *record = nullptr;
+    size_t step = 0;
+};
+
+class ReplayPlayer final : public Player {
+public:
+    using Player::Player;
+
+    void updateTankWithBattleInfo(TankAlgorithm &, SatelliteView &) override {
+    }
+};
+
+class ReplayTankAlgorithm final : public TankAlgorithm {
+    const ReplayClock &clock;
+    size_t tank_algo_index;
+
+public:
+    ReplayTankAlgorithm(const ReplayClock &clock, const size_t tank_algo_index)
+        : clock(clock), tank_algo_index(tank_algo_index) {
+    }
+
+    ActionRequest getAction() override { return clock.record->getAction(clock.step, tank_algo_index); }
+
+    void updateBattleInfo(BattleInfo &) override {
+    }
+};
+
+class Replay {
+    const GameRecordReader &record;
+    const MapTemplate &map;
+    ReplayClock clock;
+    size_t created_tanks = 0;
+    PlayerFactory player_factory;
+    TankAlgorithmFactory tank_algorithm_factory;
+    std::unique_ptr<GameManager> game;
+
+public:
+    Replay(const GameRecordReader &record, const MapTemplate &map) : record(record), map(map) {
+        clock.record = &record;
+        player_factory = [](const int player_index, const size_t x, const size_t y, const size_t max_steps,
+                            const size_t num_shells) {
+            return std::make_unique<ReplayPlayer>(player_index, x, y, max_steps, num_shells);
+        };
+        // Tanks are created in tank algorithm order
+        tank_algorithm_factory = [this](int, int) {
+            return std::make_unique<ReplayTankAlgorithm>(clock, created_tanks++);
+        };
+    }
+
+    // Starts again from the map, or from the last keyframe at or before from_step
+    void reset(const size_t from_step) {
+        created_tanks = 0;
+        game = std::make_unique<GameManager>(player_factory, tank_algorithm_factory);
+        game->setLogging(false);
+        game->readBoard(map);
+        if (const GameKeyframe *keyframe = record.keyframeAt(from_step)) game->restore(*keyframe);
+    }
+
+    // Plays the next recorded step; false once the game is over
+    bool advance() {
+        if (game->isGameOver() || game->getStep() >= record.getStepCount()) return false;
+        clock.step = game->getStep() + 1;
+        game->runTo(clock.step);
+        return true;
+    }
+
+    void seek(const size_t step) {
+        reset(step);
+        while (game->getStep() < step && advance()) {
+        }
+    }
+
+    GameManager &getGame() const { return *game; }
+};
+
+void printHeader(const GameRecordReader &record) {
+    const GameRecordHeader &header = record.getHeader();
+    std::cout << "Map: " << header.map_name << " (" << header.width << "x" << header.height
+              << ", max_steps " << header.max_steps << ", num_shells " << header.num_shells << ")\n"
+              << "Players: " << header.algorithm1 << " vs " << header.algorithm2
+              << ", " << header.tank_count << " tanks\n"
+              << "Steps: " << record.getStepCount() << ", keyframes: " << record.getKeyframes().size()
+              << " every " << header.keyframe_interval << " steps\n";
+    if (record.hasResult()) std::cout << "Result: " << record.getResult() << "\n";
+}
+
+void printBoard(const GameManager &game) {
+    const Board &board = game.getBoard();
+    UserCommon_123456789_987654321::BoardSnapshot snapshot(board.getWidth(), board.getHeight());
+    board.fillSnapshot(snapshot);
+
+    std::cout << "\nBoard after step " << game.getStep() << ":\n";
+    for (int y = 0; y < board.getHeight(); y++) {
+        std::cout.write(snapshot.row(y), board.getWidth());
+        std::cout << '\n';
+    }
+    for (const auto tank: board.getTanks()) {
+        std::cout << "Tank " << tank->getPlayerIndex() << "." << tank->getTankIndex();
+        if (tank->isDestroyed()) {
+            std::cout << " destroyed\n";
+            continue;
+        }
+        const auto [x, y] = tank->getPosition();
+        std::cout << " at (" << x << ", " << y << ") facing " << Direction::directionToString(tank->getDirection())
+                  << ", shells " << tank->getAmmunition() << "\n";
+    }
+    if (game.isGameOver()) std::cout << "\n" << game.getGameResult() << "\n";
+}
+
+// Replays the whole game and compares it with every keyframe and the result
+bool verify(Replay &replay, const GameRecordReader &record) {
+    replay.reset(0);
+    size_t next_keyframe = 0;
+    const auto &keyframes = record.getKeyframes();
+    while (replay.advance()) {
+        const GameManager &game = replay.getGame();
+        if (next_keyframe < keyframes.size() && keyframes[next_keyframe].step == game.getStep()) {
+            if (encodeKeyframe(game.captureKeyframe()) != encodeKeyframe(keyframes[next_keyframe])) {
+                std::cerr << "State differs from the keyframe at step " << game.getStep() << std::endl;
+                return false;
+            }
+            next_keyframe++;
+        }
+    }
+
+    const GameManager &game = replay.getGame();
+    if (!record.hasResult()) {
+        std::cerr << "The record has no result, it stops at step " << record.getStepCount() << std::endl;
+        return false;
+    }
+    if (game.getStep() != record.getResultSteps() || game.getGameResult() != record.getResult()) {
+        std::cerr << "Replay ended at step " << game.getStep() << " with \"" << game.getGameResult()
+                  << "\", the record at step " << record.getResultSteps() << " with \"" << record.getResult()
+                  << "\"" << std::endl;
+        return false;
+    }
+    std::cout << "Replay matches the record: " << keyframes.size() << " keyframes, "
+              << game.getStep() << " steps" << std::endl;
+    return true;
+}
+
+} // namespace
+
+int main(const int argc, char *argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <record-file> [-map <map-file>] [-step <n>] [-verify]" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string map_file;
+    bool has_step = false;
+    size_t step = 0;
+    bool verify_only = false;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "-map") == 0 && i + 1 < argc) {
+            map_file = argv[++i];
+        } else if (strcmp(argv[i], "-step") == 0 && i + 1 < argc) {
+            has_step = true;
+            step = std::strtoul(argv[++i], nullptr, 10);
+        } else if (strcmp(argv[i], "-verify") == 0) {
+            verify_only = true;
+        } else {
+            std::cerr << "Unknown argument: " << argv[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    GameRecordReader record;
+    if (!record.load(argv[1])) return EXIT_FAILURE;
+    if (map_file.empty()) map_file = record.getHeader().map_name;
+    if (hashMapFile(map_file) != record.getHeader().map_hash) {
+        std::cerr << "Map " << map_file << " is not the map the game was recorded on" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    Logger map_log;
+    map_log.mute();
+    const auto map = MapTemplate::load(map_file, map_log);
+    if (map == nullptr) {
+        std::cerr << "Can't parse file " << map_file << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    printHeader(record);
+    Replay replay(record, *map);
+    if (verify_only) return verify(replay, record) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+    replay.seek(has_step ? step : record.getStepCount());
+    printBoard(replay.getGame());
+    return EXIT_SUCCESS;
+}
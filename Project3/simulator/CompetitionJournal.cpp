@@ -0,0 +1,139 @@
+#include "CompetitionJournal.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* const HEADER = "tank_competition_journal 1";
+
+int64_t nowTicks() {
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+} // namespace
+
+std::string CompetitionJournal::key(const std::string& game_manager, const std::string& game_maps_folder,
+                                    const std::vector<std::string>& map_names,
+                                    const std::vector<std::string>& algorithm_names,
+                                    const std::vector<uint64_t>& content_hashes) {
+    // 64-bit FNV-1a over every field, each followed by a separator that can't occur in a path
+    uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](const std::string& field) {
+        for (const char c : field) {
+            hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+        }
+        hash = (hash ^ 0) * 1099511628211ULL;
+    };
+    add(game_manager);
+    add(game_maps_folder);
+    for (const auto& name : map_names) add(name);
+    add("");
+    for (const auto& name : algorithm_names) add(name);
+    add("");
+    for (const uint64_t content : content_hashes) add(std::to_string(content));
+
+    std::ostringstream hex;
+    hex << std::hex << hash;
+    return hex.str();
+}
+
+uintmax_t CompetitionJournal::load() {
+    std::ifstream in(path_, std::ios::binary);
+    std::string line;
+    if (!std::getline(in, line) || in.eof() || line != HEADER) {
+        return 0;
+    }
+    uintmax_t complete = line.size() + 1;
+
+    while (std::getline(in, line)) {
+        // A last line without its newline was cut short while being written
+        if (in.eof()) break;
+        complete += line.size() + 1;
+
+        // <map>\t<algorithm1>\t<algorithm2>\t<outcome>
+        const size_t tab1 = line.find('\t');
+        const size_t tab2 = tab1 == std::string::npos ? tab1 : line.find('\t', tab1 + 1);
+        const size_t tab3 = tab2 == std::string::npos ? tab2 : line.find('\t', tab2 + 1);
+        GameOutcome outcome;
+        if (tab3 == std::string::npos || !GameOutcome::parse(line.substr(tab3 + 1), outcome)) {
+            std::cerr << "Warning: Ignoring malformed line in journal " << path_ << std::endl;
+            continue;
+        }
+        finished_.emplace(GameKey{line.substr(0, tab1), line.substr(tab1 + 1, tab2 - tab1 - 1),
+                                  line.substr(tab2 + 1, tab3 - tab2 - 1)}, outcome);
+    }
+    return complete;
+}
+
+bool CompetitionJournal::open(const std::string& path) {
+    path_ = path;
+    finished_.clear();
+
+    std::error_code ec;
+    uintmax_t complete = 0;
+    if (fs::exists(path, ec)) {
+        complete = load();
+        // Drop a line cut short by a kill, or the whole file if it isn't a journal
+        if (complete != fs::file_size(path, ec)) {
+            fs::resize_file(path, complete, ec);
+        }
+    }
+
+    file_ = std::fopen(path.c_str(), "ab");
+    if (!file_) {
+        std::cerr << "Error: Cannot open journal " << path << std::endl;
+        finished_.clear();
+        return false;
+    }
+    if (complete == 0) {
+        std::fprintf(file_, "%s\n", HEADER);
+        std::fflush(file_);
+    }
+    last_sync_ = nowTicks();
+    return true;
+}
+
+void CompetitionJournal::record(const std::string& map, const std::string& algorithm1,
+                                const std::string& algorithm2, const GameOutcome& outcome) {
+    const std::string line = map + '\t' + algorithm1 + '\t' + algorithm2 + '\t' + outcome.format() + '\n';
+
+    // One fwrite per line; the stream's own lock keeps lines of different workers apart
+    std::fwrite(line.data(), 1, line.size(), file_);
+    std::fflush(file_);
+
+    const int64_t now = nowTicks();
+    int64_t last = last_sync_.load(std::memory_order_relaxed);
+    const int64_t interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(SYNC_INTERVAL).count();
+    if (now - last >= interval && last_sync_.compare_exchange_strong(last, now)) {
+        sync();
+    }
+}
+
+void CompetitionJournal::sync() {
+#ifndef _WIN32
+    fsync(fileno(file_));
+#endif
+}
+
+void CompetitionJournal::close() {
+    if (!file_) return;
+    std::fflush(file_);
+    sync();
+    std::fclose(file_);
+    file_ = nullptr;
+}
+
+void CompetitionJournal::remove() {
+    close();
+    std::error_code ec;
+    fs::remove(path_, ec);
+}
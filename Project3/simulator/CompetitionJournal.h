@@ -0,0 +1,85 @@
+#ifndef COMPETITION_JOURNAL_H
+#define COMPETITION_JOURNAL_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "GameOutcome.h"
+
+/**
+ * Journal of the finished games of a competition, so that a competition that
+ * was killed can be restarted with the same arguments and only play the games
+ * that are missing.
+ *
+ * The journal is a text file with one line per finished game. Each line is
+ * flushed to the file as soon as the game is recorded, so it survives the
+ * process being killed, and the file is synced to disk at most once per
+ * SYNC_INTERVAL so a crash of the machine loses at most that much. A line cut
+ * short by a kill is dropped when the journal is opened again.
+ *
+ * The file name is derived from everything that decides which games are
+ * played and how they turn out (see key()), so competitions over different
+ * or changed maps or algorithms never pick up each other's games.
+ */
+class CompetitionJournal {
+public:
+    static constexpr std::chrono::seconds SYNC_INTERVAL{1};
+
+    using GameKey = std::tuple<std::string, std::string, std::string>; ///< (map, algorithm1, algorithm2)
+
+    CompetitionJournal() = default;
+    CompetitionJournal(const CompetitionJournal&) = delete;
+    CompetitionJournal& operator=(const CompetitionJournal&) = delete;
+    ~CompetitionJournal() { close(); }
+
+    /**
+     * Hex digest identifying a competition by its game manager, maps folder, map files and algorithms,
+     * and by content_hashes of those files, so that a file replaced under the same name starts afresh
+     */
+    static std::string key(const std::string& game_manager, const std::string& game_maps_folder,
+                           const std::vector<std::string>& map_names,
+                           const std::vector<std::string>& algorithm_names,
+                           const std::vector<uint64_t>& content_hashes);
+
+    /**
+     * Open the journal, reading the games finished by an earlier run if the file exists.
+     * Returns false and prints an error if it can't be opened for writing.
+     */
+    bool open(const std::string& path);
+
+    bool isOpen() const { return file_ != nullptr; }
+
+    // Games read from the journal when it was opened
+    const std::map<GameKey, GameOutcome>& finishedGames() const { return finished_; }
+
+    /**
+     * Append one finished game. Safe to call from several workers at once.
+     */
+    void record(const std::string& map, const std::string& algorithm1, const std::string& algorithm2,
+                const GameOutcome& outcome);
+
+    void close();
+
+    /**
+     * Close and delete the journal, once the competition's results are written.
+     */
+    void remove();
+
+private:
+    std::string path_;
+    std::FILE* file_ = nullptr;
+    std::map<GameKey, GameOutcome> finished_;
+    std::atomic<int64_t> last_sync_{0}; ///< steady_clock ticks of the last sync
+
+    // Reads the earlier games and returns the length of the file up to its last complete line
+    uintmax_t load();
+    void sync();
+};
+
+#endif // COMPETITION_JOURNAL_H
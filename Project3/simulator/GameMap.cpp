@@ -0,0 +1,88 @@
+#include "GameMap.h"
+
+#include <fstream>
+#include <iostream>
+
+namespace {
+
+std::string trim(const std::string& s) {
+    const size_t start = s.find_first_not_of(" \t\r");
+    if (start == std::string::npos) return "";
+    const size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(start, end - start + 1);
+}
+
+// Parses a "<key> = <value>" header line
+bool parseField(const std::string& line, const std::string& key, size_t& value) {
+    const size_t eq = line.find('=');
+    if (eq == std::string::npos || trim(line.substr(0, eq)) != key) return false;
+
+    const std::string number = trim(line.substr(eq + 1));
+    if (number.empty() || number.find_first_not_of("0123456789") != std::string::npos) return false;
+
+    value = std::stoul(number);
+    return true;
+}
+
+bool isMapSymbol(char c) {
+    return c == '#' || c == '=' || c == '@' || c == '1' || c == '2';
+}
+
+} // namespace
+
+std::unique_ptr<GameMap> GameMap::load(const std::string& file_path) {
+    std::ifstream in(file_path);
+    if (!in.is_open()) {
+        std::cerr << "Error: Cannot open map file " << file_path << std::endl;
+        return nullptr;
+    }
+
+    std::unique_ptr<GameMap> map(new GameMap());
+    std::string line;
+    if (!std::getline(in, map->name_)) {
+        std::cerr << "Error: Map file " << file_path << " is empty" << std::endl;
+        return nullptr;
+    }
+
+    const std::pair<const char*, size_t*> fields[] = {
+        {"MaxSteps", &map->max_steps_},
+        {"NumShells", &map->num_shells_},
+        {"Rows", &map->height_},
+        {"Cols", &map->width_},
+    };
+    for (const auto& [key, value] : fields) {
+        if (!std::getline(in, line) || !parseField(line, key, *value)) {
+            std::cerr << "Error: Map file " << file_path << " is missing a valid " << key << " line" << std::endl;
+            return nullptr;
+        }
+    }
+
+    map->cells_.assign(map->width_ * map->height_, ' ');
+    for (size_t y = 0; y < map->height_ && std::getline(in, line); ++y) {
+        for (size_t x = 0; x < map->width_ && x < line.size(); ++x) {
+            if (isMapSymbol(line[x])) {
+                map->cells_[y * map->width_ + x] = line[x];
+            }
+        }
+    }
+
+    return map;
+}
+
+std::unique_ptr<GameMap> GameMap::fromCells(size_t width, size_t height, size_t max_steps, size_t num_shells,
+                                            const char* cells) {
+    std::unique_ptr<GameMap> map(new GameMap());
+    map->width_ = width;
+    map->height_ = height;
+    map->max_steps_ = max_steps;
+    map->num_shells_ = num_shells;
+    map->cells_.assign(cells, cells + width * height);
+    return map;
+}
+
+char GameMap::getObject(size_t x, size_t y) const {
+    if (x >= width_ || y >= height_) {
+        return '&';
+    }
+    return cells_[y * width_ + x];
+}
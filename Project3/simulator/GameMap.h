@@ -0,0 +1,51 @@
+#ifndef GAME_MAP_H
+#define GAME_MAP_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../common/SatelliteView.h"
+
+/**
+ * Game map read from a map file, exposed as the initial SatelliteView snapshot
+ * handed to AbstractGameManager::run.
+ *
+ * File format: a name line, then MaxSteps, NumShells, Rows and Cols lines
+ * ("Key = value", spaces optional) followed by the rows of the map. Missing
+ * rows and columns are treated as empty cells and extra ones are ignored.
+ */
+class GameMap : public SatelliteView {
+public:
+    /**
+     * Load a map file. Returns nullptr and prints an error if the header is malformed.
+     */
+    static std::unique_ptr<GameMap> load(const std::string& file_path);
+
+    /**
+     * Build a map from its header values and width * height row-major cells, as getCells() returns them.
+     */
+    static std::unique_ptr<GameMap> fromCells(size_t width, size_t height, size_t max_steps, size_t num_shells,
+                                              const char* cells);
+
+    char getObject(size_t x, size_t y) const override;
+
+    const std::string& getName() const { return name_; }
+    size_t getWidth() const { return width_; }
+    size_t getHeight() const { return height_; }
+    size_t getMaxSteps() const { return max_steps_; }
+    size_t getNumShells() const { return num_shells_; }
+    const char* getCells() const { return cells_.data(); }
+
+private:
+    std::string name_;
+    size_t width_ = 0;
+    size_t height_ = 0;
+    size_t max_steps_ = 0;
+    size_t num_shells_ = 0;
+    std::vector<char> cells_; // row-major, width_ * height_
+
+    GameMap() = default;
+};
+
+#endif // GAME_MAP_H
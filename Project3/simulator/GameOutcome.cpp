@@ -0,0 +1,67 @@
+#include "GameOutcome.h"
+
+#include <vector>
+
+namespace {
+
+bool parseNumber(const std::string& text, size_t& value) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) return false;
+    value = std::stoul(text);
+    return true;
+}
+
+} // namespace
+
+GameOutcome GameOutcome::of(const GameResult& result) {
+    GameOutcome outcome;
+    outcome.winner = result.winner;
+    outcome.reason = result.reason;
+    outcome.rounds = result.rounds;
+    outcome.tanks1 = result.remaining_tanks.size() > 0 ? result.remaining_tanks[0] : 0;
+    outcome.tanks2 = result.remaining_tanks.size() > 1 ? result.remaining_tanks[1] : 0;
+    return outcome;
+}
+
+GameResult GameOutcome::toResult() const {
+    GameResult result;
+    result.winner = winner;
+    result.reason = reason;
+    result.rounds = rounds;
+    result.remaining_tanks = {tanks1, tanks2};
+    return result;
+}
+
+std::string GameOutcome::format() const {
+    return std::to_string(winner) + '\t' + std::to_string(static_cast<int>(reason)) + '\t' +
+           std::to_string(rounds) + '\t' + std::to_string(tanks1) + '\t' + std::to_string(tanks2) + '\t' +
+           std::to_string(timed_out1) + '\t' + std::to_string(timed_out2);
+}
+
+bool GameOutcome::parse(const std::string& text, GameOutcome& outcome) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        const size_t tab = text.find('\t', start);
+        fields.push_back(text.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+        if (tab == std::string::npos) break;
+        start = tab + 1;
+    }
+    if (fields.size() != 5 && fields.size() != 7) return false;
+
+    size_t winner = 0;
+    size_t reason = 0;
+    if (!parseNumber(fields[0], winner) || winner > 2 || !parseNumber(fields[1], reason) ||
+        reason > GameResult::ZERO_SHELLS || !parseNumber(fields[2], outcome.rounds) ||
+        !parseNumber(fields[3], outcome.tanks1) || !parseNumber(fields[4], outcome.tanks2)) {
+        return false;
+    }
+    outcome.timed_out1 = 0;
+    outcome.timed_out2 = 0;
+    if (fields.size() == 7 &&
+        (!parseNumber(fields[5], outcome.timed_out1) || !parseNumber(fields[6], outcome.timed_out2))) {
+        return false;
+    }
+    outcome.winner = static_cast<int>(winner);
+    outcome.reason = static_cast<GameResult::Reason>(reason);
+    return true;
+}
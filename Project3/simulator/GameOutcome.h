@@ -0,0 +1,45 @@
+#ifndef GAME_OUTCOME_H
+#define GAME_OUTCOME_H
+
+#include <cstddef>
+#include <string>
+
+#include "../common/GameResult.h"
+
+/**
+ * The part of a GameResult that scores and per-game results are made of,
+ * without the final board, in the tab separated text form the simulator's
+ * journal and result cache store it in.
+ */
+struct GameOutcome {
+    int winner = 0;
+    GameResult::Reason reason = GameResult::MAX_STEPS;
+    size_t rounds = 0;
+    size_t tanks1 = 0;
+    size_t tanks2 = 0;
+    size_t timed_out1 = 0; ///< Tanks of player 1 that used up their per-game time limit
+    size_t timed_out2 = 0;
+
+    static GameOutcome of(const GameResult& result);
+
+    GameResult toResult() const;
+
+    // "<winner>\t<reason>\t<rounds>\t<tanks1>\t<tanks2>\t<timed_out1>\t<timed_out2>"
+    std::string format() const;
+
+    /**
+     * Parse what format() wrote, or the five fields written before time-outs were recorded.
+     * Returns false if the text is malformed.
+     */
+    static bool parse(const std::string& text, GameOutcome& outcome);
+
+    bool operator==(const GameOutcome& other) const {
+        return winner == other.winner && reason == other.reason && rounds == other.rounds &&
+               tanks1 == other.tanks1 && tanks2 == other.tanks2 && timed_out1 == other.timed_out1 &&
+               timed_out2 == other.timed_out2;
+    }
+
+    bool operator!=(const GameOutcome& other) const { return !(*this == other); }
+};
+
+#endif // GAME_OUTCOME_H
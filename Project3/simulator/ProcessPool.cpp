@@ -0,0 +1,311 @@
+#include "ProcessPool.h"
+
+#include <algorithm>
+#include <iostream>
+
+#ifndef _WIN32
+    #include <atomic>
+    #include <cerrno>
+    #include <cstdio>
+    #include <cstring>
+    #include <ctime>
+    #include <deque>
+    #include <exception>
+    #include <new>
+    #include <string>
+    #include <semaphore.h>
+    #include <signal.h>
+    #include <sys/mman.h>
+    #include <sys/wait.h>
+    #include <unistd.h>
+    #ifdef __linux__
+        #include <sys/prctl.h>
+    #endif
+#endif
+
+ProcessPool::ProcessPool(size_t num_workers, PlayFunction play)
+    : num_workers_(std::max<size_t>(1, num_workers)), play_(std::move(play)) {}
+
+#ifdef _WIN32
+
+bool ProcessPool::run(const std::vector<Game>& /* games */, const DoneFunction& /* done */) {
+    std::cerr << "Error: Worker processes are not supported on Windows" << std::endl;
+    return false;
+}
+
+#else
+
+namespace {
+
+// A task in a task ring, followed by the map's width * height cells and padded to a multiple of 8 bytes.
+// A size of 0 marks the rest of the ring as unused: the next task starts at the beginning of the ring.
+struct TaskRecord {
+    uint64_t size;
+    uint64_t game;
+    uint32_t algorithm1;
+    uint32_t algorithm2;
+    uint64_t width;
+    uint64_t height;
+    uint64_t max_steps;
+    uint64_t num_shells;
+};
+
+struct ResultRecord {
+    uint64_t game;
+    ProcessPool::Played played;
+};
+
+// Positions in the task ring only grow; the byte offset is the position modulo the ring's size
+struct WorkerShared {
+    sem_t wake;                         ///< Posted by the simulator after queuing a task
+    std::atomic<uint64_t> task_head;    ///< Written by the simulator: end of the last queued task
+    std::atomic<uint64_t> task_next;    ///< Written by the worker: start of the next task to play
+    std::atomic<uint64_t> result_head;  ///< Written by the worker: number of results ever written
+    ResultRecord results[ProcessPool::QUEUE_DEPTH];
+};
+
+struct PoolShared {
+    sem_t results_ready; ///< Posted by a worker after writing a result
+};
+
+// The simulator's side of one worker
+struct Worker {
+    WorkerShared* shared = nullptr;
+    char* ring = nullptr;
+    size_t mapped_bytes = 0;
+    pid_t pid = -1;
+    uint64_t task_tail = 0;             ///< End of the last task whose result was collected
+    uint64_t result_tail = 0;           ///< Number of results collected
+    std::deque<std::pair<size_t, uint64_t>> in_flight; ///< (game, end of its task) in ring order
+    size_t attempts = 0;                ///< Workers that died playing in_flight.front()
+};
+
+constexpr uint64_t align8(uint64_t bytes) {
+    return (bytes + 7) & ~uint64_t{7};
+}
+
+void* mapShared(size_t bytes) {
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? nullptr : memory;
+}
+
+void workerLoop(WorkerShared& shared, const char* ring, uint64_t ring_bytes, PoolShared& pool,
+                const ProcessPool::PlayFunction& play) {
+    for (size_t played = 0; played < ProcessPool::GAMES_PER_WORKER; ++played) {
+        uint64_t next = shared.task_next.load(std::memory_order_relaxed);
+        while (next == shared.task_head.load(std::memory_order_acquire)) {
+            sem_wait(&shared.wake);
+        }
+
+        // Only the size is sure to fit before the end of the ring; a wrap marker may sit in its last 8 bytes
+        uint64_t size = 0;
+        std::memcpy(&size, ring + next % ring_bytes, sizeof(size));
+        if (size == 0) {
+            next += ring_bytes - next % ring_bytes;
+        }
+        TaskRecord task;
+        std::memcpy(&task, ring + next % ring_bytes, sizeof(task));
+        const char* cells = ring + next % ring_bytes + sizeof(TaskRecord);
+        const auto map = GameMap::fromCells(task.width, task.height, task.max_steps, task.num_shells, cells);
+        const ProcessPool::Played game = play(*map, task.algorithm1, task.algorithm2);
+
+        // The result goes out before the task is marked done, so a worker that dies in between
+        // can't lose the game; its replacement starts after the collected results either way
+        const uint64_t result = shared.result_head.load(std::memory_order_relaxed);
+        shared.results[result % ProcessPool::QUEUE_DEPTH] = {task.game, game};
+        shared.result_head.store(result + 1, std::memory_order_release);
+        shared.task_next.store(next + task.size, std::memory_order_release);
+        sem_post(&pool.results_ready);
+    }
+}
+
+bool startWorker(Worker& worker, uint64_t ring_bytes, PoolShared& pool, const ProcessPool::PlayFunction& play) {
+    // Whatever is buffered would otherwise be written by the child as well
+    std::cout.flush();
+    std::cerr.flush();
+    std::fflush(nullptr);
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        std::cerr << "Error: Cannot start a worker process: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (pid == 0) {
+#ifdef __linux__
+        prctl(PR_SET_PDEATHSIG, SIGKILL);
+#endif
+        int status = 0;
+        try {
+            workerLoop(*worker.shared, worker.ring, ring_bytes, pool, play);
+        } catch (const std::exception& e) {
+            std::cerr << "Error: game failed: " << e.what() << std::endl;
+            status = 1;
+        } catch (...) {
+            std::cerr << "Error: game failed with unknown exception" << std::endl;
+            status = 1;
+        }
+        std::cout.flush();
+        std::fflush(stdout);
+        // Skip the simulator's destructors and atexit handlers, which belong to the parent
+        _exit(status);
+    }
+    worker.pid = pid;
+    return true;
+}
+
+// Queues a task if the worker's ring has room for it
+bool pushTask(Worker& worker, uint64_t ring_bytes, size_t game_index, const ProcessPool::Game& game) {
+    const GameMap& map = *game.map;
+    const uint64_t cells = static_cast<uint64_t>(map.getWidth()) * map.getHeight();
+    const uint64_t size = align8(sizeof(TaskRecord) + cells);
+
+    uint64_t head = worker.shared->task_head.load(std::memory_order_relaxed);
+    const uint64_t offset = head % ring_bytes;
+    const uint64_t pad = offset + size > ring_bytes ? ring_bytes - offset : 0;
+    if (head + pad + size - worker.task_tail > ring_bytes) return false;
+
+    if (pad > 0) {
+        const uint64_t wrap = 0;
+        std::memcpy(worker.ring + offset, &wrap, sizeof(wrap));
+        head += pad;
+    }
+    const TaskRecord task{size, game_index, game.algorithm1, game.algorithm2, map.getWidth(), map.getHeight(),
+                          map.getMaxSteps(), map.getNumShells()};
+    char* record = worker.ring + head % ring_bytes;
+    std::memcpy(record, &task, sizeof(task));
+    std::memcpy(record + sizeof(task), map.getCells(), cells);
+    head += size;
+
+    worker.shared->task_head.store(head, std::memory_order_release);
+    worker.in_flight.emplace_back(game_index, head);
+    sem_post(&worker.shared->wake);
+    return true;
+}
+
+// Hands the worker's new results to done; returns how many there were
+size_t collectResults(Worker& worker, const ProcessPool::DoneFunction& done) {
+    const uint64_t head = worker.shared->result_head.load(std::memory_order_acquire);
+    size_t collected = 0;
+    for (; worker.result_tail < head; ++worker.result_tail, ++collected) {
+        const ResultRecord result = worker.shared->results[worker.result_tail % ProcessPool::QUEUE_DEPTH];
+        worker.task_tail = worker.in_flight.front().second;
+        worker.in_flight.pop_front();
+        worker.attempts = 0;
+        done(result.game, &result.played);
+    }
+    return collected;
+}
+
+std::string describeExit(int status) {
+    if (WIFSIGNALED(status)) return std::string("killed by ") + strsignal(WTERMSIG(status));
+    return "exit code " + std::to_string(WEXITSTATUS(status));
+}
+
+} // namespace
+
+bool ProcessPool::run(const std::vector<Game>& games, const DoneFunction& done) {
+    if (games.empty()) return true;
+
+    // Room for a full queue of the largest task, and at least twice it so a task always fits an empty ring
+    uint64_t largest = 0;
+    for (const Game& game : games) {
+        largest = std::max<uint64_t>(largest, static_cast<uint64_t>(game.map->getWidth()) * game.map->getHeight());
+    }
+    largest = align8(sizeof(TaskRecord) + largest);
+    const uint64_t ring_bytes = std::max<uint64_t>(1 << 20, (QUEUE_DEPTH + 1) * largest);
+
+    auto* pool = static_cast<PoolShared*>(mapShared(sizeof(PoolShared)));
+    if (!pool) {
+        std::cerr << "Error: Cannot allocate shared memory for the worker processes" << std::endl;
+        return false;
+    }
+    sem_init(&pool->results_ready, 1, 0);
+
+    std::vector<Worker> workers(std::min(num_workers_, games.size()));
+    bool ok = true;
+    for (Worker& worker : workers) {
+        worker.mapped_bytes = align8(sizeof(WorkerShared)) + ring_bytes;
+        void* memory = mapShared(worker.mapped_bytes);
+        if (!memory) {
+            std::cerr << "Error: Cannot allocate shared memory for the worker processes" << std::endl;
+            ok = false;
+            break;
+        }
+        worker.shared = new (memory) WorkerShared();
+        worker.ring = static_cast<char*>(memory) + align8(sizeof(WorkerShared));
+        sem_init(&worker.shared->wake, 1, 0);
+        if (!startWorker(worker, ring_bytes, *pool, play_)) {
+            ok = false;
+            break;
+        }
+    }
+
+    size_t next_game = 0;
+    size_t finished = 0;
+    while (ok && finished < games.size()) {
+        for (Worker& worker : workers) {
+            while (next_game < games.size() && worker.in_flight.size() < QUEUE_DEPTH &&
+                   pushTask(worker, ring_bytes, next_game, games[next_game])) {
+                ++next_game;
+            }
+        }
+
+        // Time out now and then to notice workers that died without posting
+        timespec deadline{};
+        clock_gettime(CLOCK_REALTIME, &deadline);
+        deadline.tv_nsec += 20 * 1000 * 1000;
+        if (deadline.tv_nsec >= 1000 * 1000 * 1000) {
+            deadline.tv_sec += 1;
+            deadline.tv_nsec -= 1000 * 1000 * 1000;
+        }
+        sem_timedwait(&pool->results_ready, &deadline);
+
+        for (Worker& worker : workers) {
+            finished += collectResults(worker, done);
+
+            int status = 0;
+            if (worker.pid <= 0 || waitpid(worker.pid, &status, WNOHANG) != worker.pid) continue;
+            worker.pid = -1;
+            finished += collectResults(worker, done);
+
+            const bool retired = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+            if (!retired && !worker.in_flight.empty()) {
+                std::cerr << "Warning: A worker process was " << describeExit(status) << " during a game, "
+                          << (worker.attempts + 1 < MAX_ATTEMPTS ? "restarting it" : "giving up on the game")
+                          << std::endl;
+                if (++worker.attempts >= MAX_ATTEMPTS) {
+                    const size_t game = worker.in_flight.front().first;
+                    worker.task_tail = worker.in_flight.front().second;
+                    worker.in_flight.pop_front();
+                    worker.attempts = 0;
+                    done(game, nullptr);
+                    ++finished;
+                }
+            }
+
+            // The replacement starts from the first task without a result
+            worker.shared->task_next.store(worker.task_tail, std::memory_order_relaxed);
+            if (finished < games.size() && !startWorker(worker, ring_bytes, *pool, play_)) {
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    for (Worker& worker : workers) {
+        if (worker.pid > 0) {
+            kill(worker.pid, SIGKILL);
+            waitpid(worker.pid, nullptr, 0);
+        }
+        if (worker.shared) {
+            sem_destroy(&worker.shared->wake);
+            worker.shared->~WorkerShared();
+            munmap(worker.shared, worker.mapped_bytes);
+        }
+    }
+    sem_destroy(&pool->results_ready);
+    munmap(pool, sizeof(PoolShared));
+    return ok;
+}
+
+#endif
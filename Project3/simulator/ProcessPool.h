@@ -0,0 +1,77 @@
+#ifndef PROCESS_POOL_H
+#define PROCESS_POOL_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "GameMap.h"
+#include "GameOutcome.h"
+#include "TimedTankAlgorithm.h"
+
+/**
+ * Pool of worker processes playing games, so that a plugin that crashes or
+ * leaks takes down one worker instead of the whole simulator.
+ *
+ * The workers are forked from the simulator after it loaded its libraries
+ * and before it played any game, so every worker hosts the game manager and
+ * the algorithms just as the simulator loaded them. Each worker shares a
+ * task ring and a result ring with the simulator: a task carries a map's
+ * cells and the two algorithms, a result carries the GameOutcome and the
+ * algorithms' call timings, and the
+ * two sides only use process-shared semaphores to wake each other.
+ *
+ * A task stays in its ring until its result is collected. When a worker
+ * dies, the results it finished are collected and a new worker is forked in
+ * its place, which starts again from the first unfinished task. A game that
+ * killed MAX_ATTEMPTS workers in a row is given up on. Workers also retire
+ * after GAMES_PER_WORKER games, which frees whatever a leaking plugin
+ * accumulated.
+ *
+ * Only available on POSIX systems.
+ */
+class ProcessPool {
+public:
+    static constexpr size_t QUEUE_DEPTH = 4;        ///< Tasks queued per worker
+    static constexpr size_t MAX_ATTEMPTS = 2;
+    static constexpr size_t GAMES_PER_WORKER = 1000;
+
+    struct Game {
+        const GameMap* map;
+        uint32_t algorithm1;
+        uint32_t algorithm2;
+    };
+
+    using GameTiming = std::array<TimedTankAlgorithm::Timing, 2>; ///< Calls of player 1's and player 2's tanks
+
+    struct Played {
+        GameOutcome outcome;
+        GameTiming timing;
+    };
+
+    // Plays one game; runs in a worker process
+    using PlayFunction = std::function<Played(GameMap& map, uint32_t algorithm1, uint32_t algorithm2)>;
+
+    // Called in the simulator as games finish, with nullptr for a game that was given up on
+    using DoneFunction = std::function<void(size_t game, const Played* played)>;
+
+    ProcessPool(size_t num_workers, PlayFunction play);
+
+    ProcessPool(const ProcessPool&) = delete;
+    ProcessPool& operator=(const ProcessPool&) = delete;
+
+    /**
+     * Play every game and wait for all of them. Games are handed out in order but finish in any order.
+     * Must be called while the simulator runs no other threads, since it forks.
+     * Returns false and prints an error if the workers can't be started.
+     */
+    bool run(const std::vector<Game>& games, const DoneFunction& done);
+
+private:
+    size_t num_workers_;
+    PlayFunction play_;
+};
+
+#endif // PROCESS_POOL_H
@@ -0,0 +1,147 @@
+#include "ResultCache.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// Version 2 keys no longer include -verbose, so version 1 files are dropped
+const char* const HEADER = "tank_result_cache 2";
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ULL;
+constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+uint64_t fnv1a(uint64_t hash, const char* data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * FNV_PRIME;
+    }
+    return hash;
+}
+
+std::string formatLine(uint64_t key, const GameOutcome& outcome) {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(key));
+    return std::string(hex) + '\t' + outcome.format() + '\n';
+}
+
+} // namespace
+
+bool ResultCache::hashFile(const std::string& path, uint64_t& hash) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open()) {
+        std::cerr << "Error: Cannot read " << path << std::endl;
+        return false;
+    }
+    std::vector<char> buffer(1 << 16);
+    hash = FNV_OFFSET;
+    while (in) {
+        in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        hash = fnv1a(hash, buffer.data(), static_cast<size_t>(in.gcount()));
+    }
+    return in.eof();
+}
+
+uint64_t ResultCache::gameKey(uint64_t game_manager, uint64_t map, uint64_t algorithm1, uint64_t algorithm2,
+                              size_t max_steps, size_t num_shells) {
+    const uint64_t fields[] = {game_manager, map, algorithm1, algorithm2, max_steps, num_shells};
+    uint64_t hash = FNV_OFFSET;
+    for (const uint64_t field : fields) {
+        for (int shift = 0; shift < 64; shift += 8) {
+            hash = (hash ^ ((field >> shift) & 0xff)) * FNV_PRIME;
+        }
+    }
+    return hash;
+}
+
+uintmax_t ResultCache::load(size_t& lines) {
+    lines = 0;
+    std::ifstream in(path_, std::ios::binary);
+    std::string line;
+    if (!std::getline(in, line) || in.eof() || line != HEADER) {
+        return 0;
+    }
+    uintmax_t complete = line.size() + 1;
+
+    while (std::getline(in, line)) {
+        // A last line without its newline was cut short while being written
+        if (in.eof()) break;
+        complete += line.size() + 1;
+        ++lines;
+
+        // <key>\t<outcome>
+        GameOutcome outcome;
+        if (line.size() < 17 || line[16] != '\t' ||
+            line.find_first_not_of("0123456789abcdef") != 16 ||
+            !GameOutcome::parse(line.substr(17), outcome)) {
+            continue;
+        }
+        entries_[std::stoull(line.substr(0, 16), nullptr, 16)] = outcome;
+    }
+    return complete;
+}
+
+bool ResultCache::rewrite() {
+    const std::string temp = path_ + ".tmp";
+    std::FILE* out = std::fopen(temp.c_str(), "wb");
+    if (!out) return false;
+    std::fprintf(out, "%s\n", HEADER);
+    for (const auto& [key, outcome] : entries_) {
+        const std::string line = formatLine(key, outcome);
+        std::fwrite(line.data(), 1, line.size(), out);
+    }
+    const bool ok = std::fclose(out) == 0;
+    std::error_code ec;
+    if (ok) fs::rename(temp, path_, ec);
+    return ok && !ec;
+}
+
+bool ResultCache::open(const std::string& path) {
+    path_ = path;
+    entries_.clear();
+
+    std::error_code ec;
+    uintmax_t complete = 0;
+    if (fs::exists(path, ec)) {
+        size_t lines = 0;
+        complete = load(lines);
+        if (lines > 2 * entries_.size() + 1024 && rewrite()) {
+            complete = fs::file_size(path, ec);
+        } else if (complete != fs::file_size(path, ec)) {
+            // Drop a line cut short by a kill, or the whole file if it isn't a cache
+            fs::resize_file(path, complete, ec);
+        }
+    }
+
+    file_ = std::fopen(path.c_str(), "ab");
+    if (!file_) {
+        std::cerr << "Error: Cannot open result cache " << path << std::endl;
+        entries_.clear();
+        return false;
+    }
+    if (complete == 0) {
+        std::fprintf(file_, "%s\n", HEADER);
+    }
+    return true;
+}
+
+const GameOutcome* ResultCache::find(uint64_t key) const {
+    auto it = entries_.find(key);
+    return it == entries_.end() ? nullptr : &it->second;
+}
+
+void ResultCache::store(uint64_t key, const GameOutcome& outcome) {
+    // One fwrite per line; the stream's own lock keeps lines of different workers apart
+    const std::string line = formatLine(key, outcome);
+    std::fwrite(line.data(), 1, line.size(), file_);
+    std::fflush(file_);
+}
+
+void ResultCache::close() {
+    if (!file_) return;
+    std::fclose(file_);
+    file_ = nullptr;
+}
@@ -0,0 +1,72 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+
+#include "GameOutcome.h"
+
+/**
+ * Outcomes of games played by earlier runs of the simulator, so that a game
+ * whose inputs haven't changed isn't played again.
+ *
+ * A game is keyed by the contents of the game manager library, of the map
+ * file and of both algorithm libraries, by which algorithm plays first, and
+ * by the map's MaxSteps and NumShells. This relies on game managers and
+ * algorithms being deterministic, which is why the simulator can skip the
+ * cache or re-run a sample of the cached games to check it.
+ *
+ * The cache is a text file with a line per game, appended to as games
+ * finish; a later line for the same key replaces an earlier one. The file is
+ * rewritten without the replaced lines when they outnumber the live ones.
+ */
+class ResultCache {
+public:
+    ResultCache() = default;
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+    ~ResultCache() { close(); }
+
+    /**
+     * 64-bit FNV-1a hash of a file's contents. Returns false and prints an error if it can't be read.
+     */
+    static bool hashFile(const std::string& path, uint64_t& hash);
+
+    static uint64_t gameKey(uint64_t game_manager, uint64_t map, uint64_t algorithm1, uint64_t algorithm2,
+                            size_t max_steps, size_t num_shells);
+
+    /**
+     * Read the cache, creating it if needed. Returns false and prints an error if it can't be written.
+     */
+    bool open(const std::string& path);
+
+    bool isOpen() const { return file_ != nullptr; }
+
+    size_t size() const { return entries_.size(); }
+
+    /**
+     * The cached outcome, or nullptr. Must not be called while games are storing results.
+     */
+    const GameOutcome* find(uint64_t key) const;
+
+    /**
+     * Append the outcome of a game, flushed like a journal line so a killed run keeps it.
+     * Safe to call from several workers at once.
+     */
+    void store(uint64_t key, const GameOutcome& outcome);
+
+    void close();
+
+private:
+    std::string path_;
+    std::FILE* file_ = nullptr;
+    std::unordered_map<uint64_t, GameOutcome> entries_;
+
+    // Reads the entries and returns the length of the file up to its last complete line
+    uintmax_t load(size_t& lines);
+    bool rewrite();
+};
+
+#endif // RESULT_CACHE_H
@@ -0,0 +1,123 @@
+#include "ResultStream.h"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+
+const char* reasonName(GameResult::Reason reason) {
+    switch (reason) {
+        case GameResult::ALL_TANKS_DEAD: return "all_tanks_dead";
+        case GameResult::ZERO_SHELLS: return "zero_shells";
+        case GameResult::MAX_STEPS: break;
+    }
+    return "max_steps";
+}
+
+void appendJsonString(std::string& out, const std::string& value) {
+    static constexpr char hex[] = "0123456789abcdef";
+    out += '"';
+    for (const char c : value) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out += "\\u00";
+            out += hex[(c >> 4) & 0xf];
+            out += hex[c & 0xf];
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void appendCsvField(std::string& out, const std::string& value) {
+    if (value.find_first_of(",\"\r\n") == std::string::npos) {
+        out += value;
+        return;
+    }
+    out += '"';
+    for (const char c : value) {
+        if (c == '"') out += '"';
+        out += c;
+    }
+    out += '"';
+}
+
+} // namespace
+
+bool ResultStream::open(const std::string& path, size_t num_shards) {
+    path_ = path;
+    csv_ = path.size() >= 4 && path.compare(path.size() - 4, 4, ".csv") == 0;
+    out_.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!out_.is_open()) {
+        std::cerr << "Error: Cannot create results file " << path << std::endl;
+        return false;
+    }
+    shards_ = std::vector<Shard>(std::max<size_t>(1, num_shards));
+    if (csv_) {
+        out_ << "map,algorithm1,algorithm2,winner,reason,rounds,tanks1,tanks2,timed_out1,timed_out2\n";
+    }
+    return true;
+}
+
+void ResultStream::add(size_t shard_index, const std::string& map, const std::string& algorithm1,
+                       const std::string& algorithm2, const GameOutcome& outcome) {
+    Shard& shard = shards_[shard_index];
+    std::string& line = shard.buffer;
+    const auto now = std::chrono::steady_clock::now();
+    if (line.empty()) shard.oldest = now;
+
+    if (csv_) {
+        appendCsvField(line, map);
+        line += ',';
+        appendCsvField(line, algorithm1);
+        line += ',';
+        appendCsvField(line, algorithm2);
+        line += ',' + std::to_string(outcome.winner) + ',' + reasonName(outcome.reason) + ',' +
+                std::to_string(outcome.rounds) + ',' + std::to_string(outcome.tanks1) + ',' +
+                std::to_string(outcome.tanks2) + ',' + std::to_string(outcome.timed_out1) + ',' +
+                std::to_string(outcome.timed_out2) + '\n';
+    } else {
+        line += "{\"map\":";
+        appendJsonString(line, map);
+        line += ",\"algorithm1\":";
+        appendJsonString(line, algorithm1);
+        line += ",\"algorithm2\":";
+        appendJsonString(line, algorithm2);
+        line += ",\"winner\":" + std::to_string(outcome.winner) + ",\"reason\":\"" + reasonName(outcome.reason) +
+                "\",\"rounds\":" + std::to_string(outcome.rounds) + ",\"tanks\":[" + std::to_string(outcome.tanks1) +
+                ',' + std::to_string(outcome.tanks2) + "],\"timed_out\":[" + std::to_string(outcome.timed_out1) + ',' +
+                std::to_string(outcome.timed_out2) + "]}\n";
+    }
+
+    if (shard.buffer.size() < FLUSH_BYTES && now - shard.oldest < FLUSH_INTERVAL) return;
+    if (shard.buffer.size() < MAX_SHARD_BYTES) {
+        std::unique_lock<std::mutex> lock(file_mutex_, std::try_to_lock);
+        if (lock.owns_lock()) writeShard(shard);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    writeShard(shard);
+}
+
+void ResultStream::writeShard(Shard& shard) {
+    out_.write(shard.buffer.data(), static_cast<std::streamsize>(shard.buffer.size()));
+    out_.flush();
+    shard.buffer.clear();
+}
+
+bool ResultStream::close() {
+    if (!out_.is_open()) return true;
+    for (Shard& shard : shards_) {
+        if (!shard.buffer.empty()) writeShard(shard);
+    }
+    shards_.clear();
+    const bool ok = static_cast<bool>(out_);
+    out_.close();
+    if (!ok) {
+        std::cerr << "Error: Failed writing results file " << path_ << std::endl;
+    }
+    return ok;
+}
@@ -0,0 +1,77 @@
+#ifndef RESULT_STREAM_H
+#define RESULT_STREAM_H
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "GameOutcome.h"
+
+/**
+ * Per-game results file written while a competition is still running: one
+ * line per finished game, as JSON lines, or as CSV when the file name ends in
+ * ".csv". Each line counts the tanks of either player that were timed out
+ * for using up their per-game time limit, so a slow algorithm can be told
+ * apart from a passive one.
+ *
+ * Every worker appends its games to its own shard and only takes the file
+ * lock to write out a whole block of lines: once the shard holds FLUSH_BYTES,
+ * or its oldest line has waited FLUSH_INTERVAL. If another worker holds the
+ * lock it keeps the block and goes on with its next game, so workers only
+ * wait for each other once a shard grows past MAX_SHARD_BYTES. close() writes
+ * out what is left in the shards. A killed competition can lose the lines
+ * still in the shards; the competition journal keeps those games.
+ *
+ * Lines of one worker are in the order its games finished; across workers
+ * the order is arbitrary.
+ */
+class ResultStream {
+public:
+    static constexpr size_t FLUSH_BYTES = 16 * 1024;      ///< Shard size at which a worker tries to write out
+    static constexpr size_t MAX_SHARD_BYTES = 256 * 1024; ///< Shard size at which a worker waits for the file
+    static constexpr std::chrono::seconds FLUSH_INTERVAL{1}; ///< Age of the oldest line at which a worker tries to write out
+
+    ResultStream() = default;
+    ResultStream(const ResultStream&) = delete;
+    ResultStream& operator=(const ResultStream&) = delete;
+    ~ResultStream() { close(); }
+
+    /**
+     * Create the file, with one shard per worker. Returns false and prints an error if it can't be created.
+     */
+    bool open(const std::string& path, size_t num_shards);
+
+    bool isOpen() const { return out_.is_open(); }
+
+    /**
+     * Append one finished game to a shard. Safe to call concurrently as long as
+     * no two threads use the same shard at the same time.
+     */
+    void add(size_t shard, const std::string& map, const std::string& algorithm1, const std::string& algorithm2,
+             const GameOutcome& outcome);
+
+    /**
+     * Write out every shard and close the file. Returns false and prints an error if a write failed.
+     */
+    bool close();
+
+private:
+    // Own cache line per shard, so workers appending to neighbouring shards don't slow each other down
+    struct alignas(64) Shard {
+        std::string buffer;
+        std::chrono::steady_clock::time_point oldest; ///< When the first line in buffer was added
+    };
+
+    std::string path_;
+    bool csv_ = false;
+    std::ofstream out_;
+    std::mutex file_mutex_;
+    std::vector<Shard> shards_;
+
+    void writeShard(Shard& shard);
+};
+
+#endif // RESULT_STREAM_H
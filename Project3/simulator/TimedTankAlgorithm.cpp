@@ -0,0 +1,108 @@
+#include "TimedTankAlgorithm.h"
+
+#include <algorithm>
+#include <iostream>
+#include <utility>
+
+namespace {
+
+size_t bucketOf(uint64_t ns) {
+    size_t bits = 0;
+    for (; ns != 0; ns >>= 1) ++bits;
+    return bits;
+}
+
+} // namespace
+
+void TimedTankAlgorithm::Timing::add(Duration elapsed) {
+    const auto ns = static_cast<uint64_t>(std::max<int64_t>(0, elapsed.count()));
+    buckets[bucketOf(ns)]++;
+    calls++;
+    max_ns = std::max(max_ns, ns);
+}
+
+void TimedTankAlgorithm::Timing::merge(const Timing& other) {
+    for (size_t b = 0; b < BUCKETS; ++b) buckets[b] += other.buckets[b];
+    calls += other.calls;
+    max_ns = std::max(max_ns, other.max_ns);
+    overruns += other.overruns;
+    timed_out += other.timed_out;
+}
+
+uint64_t TimedTankAlgorithm::Timing::percentileNs(double fraction) const {
+    if (calls == 0) return 0;
+    const auto rank = static_cast<uint64_t>(fraction * static_cast<double>(calls - 1)) + 1;
+    uint64_t seen = 0;
+    for (size_t b = 0; b < BUCKETS; ++b) {
+        seen += buckets[b];
+        if (seen >= rank) return b == 0 ? 0 : std::min(max_ns, b >= 64 ? UINT64_MAX : (uint64_t{1} << b) - 1);
+    }
+    return max_ns;
+}
+
+std::string TimedTankAlgorithm::Timing::format() const {
+    return "calls " + std::to_string(calls) + ", p50 " + std::to_string(percentileNs(0.5)) + " ns, p99 " +
+           std::to_string(percentileNs(0.99)) + " ns, max " + std::to_string(max_ns) + " ns, overruns " +
+           std::to_string(overruns) + ", timed out tanks " + std::to_string(timed_out);
+}
+
+TimedTankAlgorithm::TimedTankAlgorithm(std::unique_ptr<TankAlgorithm> algorithm, const Limits& limits,
+                                       std::string name, Timing* timing)
+    : algorithm_(std::move(algorithm)), limits_(limits), name_(std::move(name)), timing_(timing) {}
+
+ActionRequest TimedTankAlgorithm::getAction() {
+    if (timed_out_) return ActionRequest::DoNothing;
+    if (!limits_.any()) return algorithm_->getAction();
+
+    const auto start = std::chrono::steady_clock::now();
+    const ActionRequest action = algorithm_->getAction();
+    return record(std::chrono::steady_clock::now() - start) ? action : ActionRequest::DoNothing;
+}
+
+void TimedTankAlgorithm::updateBattleInfo(BattleInfo& info) {
+    if (timed_out_) return;
+    if (!limits_.any()) {
+        algorithm_->updateBattleInfo(info);
+        return;
+    }
+
+    // The information is delivered either way; a slow call only counts against the limits
+    const auto start = std::chrono::steady_clock::now();
+    algorithm_->updateBattleInfo(info);
+    record(std::chrono::steady_clock::now() - start);
+}
+
+bool TimedTankAlgorithm::record(Duration elapsed) {
+    total_ += elapsed;
+    if (timing_) timing_->add(elapsed);
+
+    bool within = true;
+    if (limits_.per_call.count() > 0 && elapsed > limits_.per_call) {
+        within = false;
+        if (timing_) timing_->overruns++;
+        if (!warned_overrun_) {
+            warned_overrun_ = true;
+            // One write per message, so lines of concurrent games don't interleave
+            std::cerr << ("Warning: " + name_ + " took " + std::to_string(elapsed.count() / 1000000) +
+                          " ms for a call, over the per-call limit; its slow actions are replaced by DoNothing\n");
+        }
+    }
+    if (limits_.per_game.count() > 0 && total_ > limits_.per_game) {
+        within = false;
+        timed_out_ = true;
+        if (timing_) timing_->timed_out++;
+        std::cerr << ("Warning: " + name_ + " used up its per-game time limit and does nothing for the rest of the game\n");
+    }
+    return within;
+}
+
+TankAlgorithmFactory TimedTankAlgorithm::wrap(TankAlgorithmFactory factory, const Limits& limits,
+                                             const std::string& name, Timing* timing) {
+    if (!limits.any()) return factory;
+    return [factory = std::move(factory), limits, name, timing](int player_index, int tank_index) -> std::unique_ptr<TankAlgorithm> {
+        auto algorithm = factory(player_index, tank_index);
+        if (!algorithm) return algorithm;
+        return std::make_unique<TimedTankAlgorithm>(std::move(algorithm), limits,
+            name + " player " + std::to_string(player_index) + " tank " + std::to_string(tank_index), timing);
+    };
+}
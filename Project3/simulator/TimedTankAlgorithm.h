@@ -0,0 +1,93 @@
+#ifndef TIMED_TANK_ALGORITHM_H
+#define TIMED_TANK_ALGORITHM_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "../common/TankAlgorithm.h"
+
+/**
+ * Tank algorithm that holds the algorithm it wraps to the simulator's time
+ * limits, so a slow or hanging algorithm can't stall a competition worker
+ * whichever game manager plays the game.
+ *
+ * The rules are those of the engine's AlgorithmBudget: calls can't be cut
+ * short, so the action of a getAction call that took longer than the per-call
+ * limit is replaced by DoNothing, and once the calls of one tank used up the
+ * per-game limit the wrapped algorithm isn't called again and the tank does
+ * nothing for the rest of the game. Both count getAction and updateBattleInfo.
+ *
+ * Every timed call also goes into the Timing of its side of the game, so the
+ * simulator can report the algorithms' latency and mark timed out tanks in
+ * the results. Without limits nothing is wrapped and nothing is timed.
+ */
+class TimedTankAlgorithm : public TankAlgorithm {
+public:
+    using Duration = std::chrono::nanoseconds;
+
+    struct Limits {
+        Duration per_call{0}; ///< Zero is no limit
+        Duration per_game{0}; ///< Zero is no limit
+
+        bool any() const { return per_call.count() > 0 || per_game.count() > 0; }
+    };
+
+    /**
+     * Calls of one algorithm's tanks, in a fixed size histogram like the engine's
+     * StepProfile: bucket b counts the calls of b significant bits of nanoseconds,
+     * so p50 and p99 are the upper bounds of power of two buckets.
+     * Plain data, so it can be summed over games and sent between processes.
+     */
+    struct Timing {
+        static constexpr size_t BUCKETS = 65;
+
+        std::array<uint64_t, BUCKETS> buckets{};
+        uint64_t calls = 0;
+        uint64_t max_ns = 0;
+        uint64_t overruns = 0;   ///< Calls longer than the per-call limit
+        uint64_t timed_out = 0;  ///< Tanks that used up the per-game limit
+
+        void add(Duration elapsed);
+
+        void merge(const Timing& other);
+
+        // Upper bound of the bucket holding the given fraction of the calls, in nanoseconds
+        uint64_t percentileNs(double fraction) const;
+
+        // "calls <n>, p50 <ns> ns, p99 <ns> ns, max <ns> ns, overruns <n>, timed out tanks <n>"
+        std::string format() const;
+    };
+
+    TimedTankAlgorithm(std::unique_ptr<TankAlgorithm> algorithm, const Limits& limits, std::string name,
+                       Timing* timing);
+
+    ActionRequest getAction() override;
+
+    void updateBattleInfo(BattleInfo& info) override;
+
+    /**
+     * Factory making the tanks of factory, each wrapped with the limits and recording into timing,
+     * which must outlive the tanks; name identifies the algorithm in warnings.
+     * Returns factory itself when no limit is set.
+     */
+    static TankAlgorithmFactory wrap(TankAlgorithmFactory factory, const Limits& limits, const std::string& name,
+                                     Timing* timing);
+
+private:
+    std::unique_ptr<TankAlgorithm> algorithm_;
+    Limits limits_;
+    std::string name_; ///< "<algorithm> player <p> tank <t>"
+    Timing* timing_;   ///< Shared by the tanks of one side of one game, which all run on the game's thread
+    Duration total_{0};
+    bool warned_overrun_ = false;
+    bool timed_out_ = false;
+
+    // Adds a call to the tank's total; returns false if the call broke a limit
+    bool record(Duration elapsed);
+};
+
+#endif // TIMED_TANK_ALGORITHM_H
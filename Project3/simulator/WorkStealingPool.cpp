@@ -0,0 +1,94 @@
+#include "WorkStealingPool.h"
+
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <thread>
+
+namespace {
+
+// Set by workerLoop for the thread running it
+thread_local size_t current_worker = 0;
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(size_t num_workers) {
+    num_workers = std::max<size_t>(1, num_workers);
+    queues_.reserve(num_workers);
+    for (size_t i = 0; i < num_workers; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+}
+
+void WorkStealingPool::submit(Task task) {
+    WorkerQueue& queue = *queues_[next_queue_];
+    next_queue_ = (next_queue_ + 1) % queues_.size();
+
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.tasks.push_back(std::move(task));
+    pending_++;
+}
+
+void WorkStealingPool::run() {
+    const size_t threads_needed = std::min(queues_.size(), pending_.load());
+    if (threads_needed <= 1) {
+        // Single thread mode: drain every queue on the calling thread
+        for (size_t i = 0; i < queues_.size(); ++i) {
+            workerLoop(i);
+        }
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads_needed);
+    for (size_t i = 0; i < threads_needed; ++i) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t WorkStealingPool::currentWorker() {
+    return current_worker;
+}
+
+bool WorkStealingPool::popLocal(size_t worker, Task& task) {
+    WorkerQueue& queue = *queues_[worker];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t thief, Task& task) {
+    // Visit every other queue once, starting right after the thief
+    for (size_t offset = 1; offset < queues_.size(); ++offset) {
+        WorkerQueue& victim = *queues_[(thief + offset) % queues_.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(size_t worker) {
+    // No task is submitted while running, so an unsuccessful steal means every queue is drained
+    current_worker = worker;
+    Task task;
+    while (popLocal(worker, task) || steal(worker, task)) {
+        try {
+            task();
+        } catch (const std::exception& e) {
+            std::cerr << "Error: task failed: " << e.what() << std::endl;
+        } catch (...) {
+            std::cerr << "Error: task failed with unknown exception" << std::endl;
+        }
+        task = nullptr;
+        pending_--;
+    }
+    current_worker = 0;
+}
@@ -0,0 +1,67 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Fixed-size thread pool with one task deque per worker.
+ *
+ * Tasks are dealt round-robin to the workers before run() starts. A worker
+ * pops from the back of its own deque and, once it runs dry, steals from the
+ * front of another worker's deque, so a few very long games cannot leave the
+ * remaining workers idle the way static striping does.
+ *
+ * A pool with at most one worker runs every task on the calling thread.
+ */
+class WorkStealingPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingPool(size_t num_workers);
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * Queue a task. Must be called before run().
+     */
+    void submit(Task task);
+
+    /**
+     * Run all submitted tasks and block until every one of them finished.
+     * Only as many threads as there are tasks are started.
+     */
+    void run();
+
+    size_t workerCount() const { return queues_.size(); }
+
+    size_t pendingTasks() const { return pending_.load(); }
+
+    /**
+     * Index of the worker running the calling task, below workerCount(), so tasks
+     * can keep per-worker state without locking. 0 outside of run().
+     */
+    static size_t currentWorker();
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::atomic<size_t> pending_{0};
+    size_t next_queue_ = 0;
+
+    bool popLocal(size_t worker, Task& task);
+    bool steal(size_t thief, Task& task);
+    void workerLoop(size_t worker);
+};
+
+#endif // WORK_STEALING_POOL_H
@@ -1,15 +1,18 @@
 #include <iostream>
 #include <vector>
 #include <string>
-#include <thread>
-#include <mutex>
+#include <atomic>
 #include <map>
+#include <mutex>
+#include <set>
 #include <algorithm>
 #include <filesystem>
 #include <fstream>
 #include <chrono>
 #include <sstream>
 #include <iomanip>
+#include <optional>
+#include <random>
 
 #ifdef _WIN32
     #include <windows.h>
@@ -27,6 +30,13 @@
 #include "../common/TankAlgorithm.h"
 #include "../common/SatelliteView.h"
 #include "../common/GameResult.h"
+#include "CompetitionJournal.h"
+#include "GameMap.h"
+#include "ProcessPool.h"
+#include "ResultCache.h"
+#include "ResultStream.h"
+#include "TimedTankAlgorithm.h"
+#include "WorkStealingPool.h"
 
 namespace fs = std::filesystem;
 
@@ -34,6 +44,11 @@ struct CommandLineArgs {
     bool comparative_mode = false;
     bool competition_mode = false;
     bool verbose = false;
+    bool isolated = false;    ///< Play the games of a competition in worker processes
+    bool no_cache = false;    ///< Play every game, without reading or writing the result cache (implied by -verbose)
+    double verify_cache = 0;  ///< Fraction of the cached games to play again and compare
+    double algorithm_call_ms = 0; ///< Longest a tank algorithm call may take, 0 for no limit
+    double algorithm_game_ms = 0; ///< Time one tank's algorithm calls may take over a game, 0 for no limit
     int num_threads = 1;
     std::string game_map;
     std::string game_maps_folder;
@@ -42,6 +57,19 @@ struct CommandLineArgs {
     std::string algorithms_folder;
     std::string algorithm1;
     std::string algorithm2;
+    std::string results_file; ///< Optional per-game results of a competition, JSON lines or .csv
+};
+
+/**
+ * Player used for algorithm libraries that do not export createPlayer.
+ * It never forwards battle info, so such tanks play without satellite data.
+ */
+class PassivePlayer : public Player {
+public:
+    PassivePlayer(int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells)
+        : Player(player_index, x, y, max_steps, num_shells) {}
+
+    void updateTankWithBattleInfo(TankAlgorithm& /* tank */, SatelliteView& /* satellite_view */) override {}
 };
 
 class Simulator {
@@ -50,9 +78,7 @@ private:
     std::map<std::string, std::function<std::unique_ptr<AbstractGameManager>(bool)>> game_manager_factories;
     std::map<std::string, std::function<std::unique_ptr<Player>(int, size_t, size_t, size_t, size_t)>> player_factories;
     std::map<std::string, std::function<std::unique_ptr<TankAlgorithm>(int, int)>> algorithm_factories;
-    
-    std::vector<GameResult> results;
-    std::mutex results_mutex;
+    std::map<std::string, std::string> library_paths; // library name -> file it was loaded from
     
     std::string getCurrentTimeString() {
         auto now = std::chrono::system_clock::now();
@@ -66,6 +92,148 @@ private:
         return ss.str();
     }
 
+    std::unique_ptr<Player> createPlayer(const std::string& algorithm_name, int player_index, const GameMap& map) const {
+        auto it = player_factories.find(algorithm_name);
+        if (it != player_factories.end()) {
+            return it->second(player_index, map.getWidth(), map.getHeight(), map.getMaxSteps(), map.getNumShells());
+        }
+        return std::make_unique<PassivePlayer>(player_index, map.getWidth(), map.getHeight(),
+                                               map.getMaxSteps(), map.getNumShells());
+    }
+
+    using GameTiming = ProcessPool::GameTiming;
+    
+    static TimedTankAlgorithm::Limits algorithmLimits(const CommandLineArgs& args) {
+        TimedTankAlgorithm::Limits limits;
+        limits.per_call = std::chrono::nanoseconds(static_cast<int64_t>(args.algorithm_call_ms * 1e6));
+        limits.per_game = std::chrono::nanoseconds(static_cast<int64_t>(args.algorithm_game_ms * 1e6));
+        return limits;
+    }
+
+    // Runs one game; safe to call concurrently since the factory maps are read-only by now.
+    // Under time limits, the calls of each player's tanks are timed into timing[0] and timing[1].
+    GameResult runGame(const GameManagerFactory& gm_factory, GameMap& map,
+                       const std::string& algorithm1, const std::string& algorithm2, bool verbose,
+                       const TimedTankAlgorithm::Limits& limits, GameTiming& timing) const {
+        auto game_manager = gm_factory(verbose);
+        auto player1 = createPlayer(algorithm1, 1, map);
+        auto player2 = createPlayer(algorithm2, 2, map);
+        TankAlgorithmFactory algo1_factory =
+            TimedTankAlgorithm::wrap(algorithm_factories.at(algorithm1), limits, algorithm1, &timing[0]);
+        TankAlgorithmFactory algo2_factory =
+            TimedTankAlgorithm::wrap(algorithm_factories.at(algorithm2), limits, algorithm2, &timing[1]);
+
+        return game_manager->run(map.getWidth(), map.getHeight(), map,
+                                 map.getMaxSteps(), map.getNumShells(),
+                                 *player1, *player2, algo1_factory, algo2_factory);
+    }
+
+    // Competition game still to be played
+    struct PendingGame {
+        std::shared_ptr<GameMap> map;
+        const std::string* map_name;
+        size_t algorithm1;
+        size_t algorithm2;
+        bool cacheable;
+        uint64_t cache_key;
+        std::optional<GameOutcome> cached; ///< Cached outcome the game is played again to verify
+    };
+
+    // Game managers that reported the same outcome for the comparative map
+    struct ComparativeGroup {
+        std::vector<std::string> game_managers;
+        std::string message;
+        size_t rounds = 0;
+        std::string board;
+    };
+
+    static std::string resultMessage(const GameResult& result, size_t max_steps) {
+        std::ostringstream msg;
+        const size_t p1 = result.remaining_tanks.size() > 0 ? result.remaining_tanks[0] : 0;
+        const size_t p2 = result.remaining_tanks.size() > 1 ? result.remaining_tanks[1] : 0;
+        if (result.winner != 0) {
+            msg << "Player " << result.winner << " won with " << (result.winner == 1 ? p1 : p2)
+                << " tanks still alive";
+        } else if (result.reason == GameResult::ALL_TANKS_DEAD) {
+            msg << "Tie, both players have zero tanks";
+        } else if (result.reason == GameResult::ZERO_SHELLS) {
+            msg << "Tie, both players have zero shells for 40 steps";
+        } else {
+            msg << "Tie, reached max steps = " << max_steps << ", player 1 has " << p1
+                << " tanks, player 2 has " << p2 << " tanks";
+        }
+        return msg.str();
+    }
+
+    static GameOutcome outcomeOf(const GameResult& result, const GameTiming& timing) {
+        GameOutcome outcome = GameOutcome::of(result);
+        outcome.timed_out1 = timing[0].timed_out;
+        outcome.timed_out2 = timing[1].timed_out;
+        return outcome;
+    }
+    
+    // Latency of every algorithm's calls over the games played under time limits
+    static void writeLatency(std::ostream& out, const std::map<std::string, TimedTankAlgorithm::Timing>& timings) {
+        out << "Algorithm latency:" << std::endl;
+        for (const auto& [name, timing] : timings) {
+            out << "  " << name << ": " << timing.format() << std::endl;
+        }
+    }
+    
+    static std::string renderBoard(const SatelliteView* view, size_t width, size_t height) {
+        std::string board;
+        if (!view) return board;
+        board.reserve((width + 1) * height);
+        for (size_t y = 0; y < height; ++y) {
+            for (size_t x = 0; x < width; ++x) {
+                board += view->getObject(x, y);
+            }
+            board += '\n';
+        }
+        return board;
+    }
+
+    void writeComparativeResults(std::ostream& out, const CommandLineArgs& args,
+                                 const std::vector<ComparativeGroup>& groups) const {
+        out << "game_map=" << args.game_map << std::endl;
+        out << "algorithm1=" << args.algorithm1 << std::endl;
+        out << "algorithm2=" << args.algorithm2 << std::endl;
+        out << std::endl;
+        for (size_t g = 0; g < groups.size(); ++g) {
+            if (g > 0) out << std::endl;
+            const ComparativeGroup& group = groups[g];
+            for (size_t i = 0; i < group.game_managers.size(); ++i) {
+                out << (i > 0 ? "," : "") << group.game_managers[i];
+            }
+            out << std::endl;
+            out << group.message << std::endl;
+            out << group.rounds << std::endl;
+            out << group.board;
+        }
+    }
+
+    // 3 points for a win, 1 each for a tie
+    static void addScores(std::vector<std::atomic<int>>& scores, size_t a, size_t b, int winner) {
+        if (winner == 1) {
+            scores[a].fetch_add(3, std::memory_order_relaxed);
+        } else if (winner == 2) {
+            scores[b].fetch_add(3, std::memory_order_relaxed);
+        } else {
+            scores[a].fetch_add(1, std::memory_order_relaxed);
+            scores[b].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void writeCompetitionResults(std::ostream& out, const CommandLineArgs& args,
+                                 const std::vector<std::pair<std::string, int>>& sorted_scores) const {
+        out << "game_maps_folder=" << args.game_maps_folder << std::endl;
+        out << "game_manager=" << args.game_manager << std::endl;
+        out << std::endl;
+        for (const auto& [name, score] : sorted_scores) {
+            out << name << " " << score << std::endl;
+        }
+    }
+
 public:
     ~Simulator() {
         for (void* lib : loaded_libraries) {
@@ -81,6 +249,7 @@ public:
         }
         
         loaded_libraries.push_back(handle);
+        library_paths[fs::path(library_path).stem().string()] = library_path;
         
         // Try to load GameManager factory
         auto gm_factory = (std::unique_ptr<AbstractGameManager>(*)(bool))dlsym(handle, "createGameManager");
@@ -143,31 +312,93 @@ public:
             return false;
         }
         
-        // Run comparative analysis
-        std::map<std::string, std::vector<std::string>> result_groups;
+        const std::string algo1 = fs::path(args.algorithm1).stem().string();
+        const std::string algo2 = fs::path(args.algorithm2).stem().string();
+        if (!algorithm_factories.count(algo1) || !algorithm_factories.count(algo2)) {
+            std::cerr << "Error: Algorithm libraries must export createTankAlgorithm" << std::endl;
+            return false;
+        }
+        
+        // The map is parsed once and only read by the game managers, so every game shares it
+        auto map = GameMap::load(args.game_map);
+        if (!map) {
+            return false;
+        }
         
+        std::vector<std::string> gm_names;
+        std::vector<const GameManagerFactory*> gm_factories;
         for (const auto& [gm_name, gm_factory] : game_manager_factories) {
-            // TODO: Run game with both algorithms and collect results
-            // For now, placeholder implementation
+            gm_names.push_back(gm_name);
+            gm_factories.push_back(&gm_factory);
+        }
+        
+        // One task per game manager; each writes only its own slot, so no lock is needed
+        std::vector<std::optional<GameResult>> gm_results(gm_names.size());
+        std::vector<GameTiming> gm_timings(gm_names.size());
+        WorkStealingPool pool(args.num_threads);
+        for (size_t i = 0; i < gm_names.size(); ++i) {
+            pool.submit([this, &args, &gm_factories, &gm_results, &gm_timings, &map, &algo1, &algo2, i]() {
+                gm_results[i] = runGame(*gm_factories[i], *map, algo1, algo2, args.verbose, algorithmLimits(args),
+                                        gm_timings[i]);
+            });
+        }
+        pool.run();
+        if (algorithmLimits(args).any()) {
+            std::map<std::string, TimedTankAlgorithm::Timing> timings;
+            for (const GameTiming& timing : gm_timings) {
+                timings[algo1].merge(timing[0]);
+                timings[algo2].merge(timing[1]);
+            }
+            writeLatency(std::cout, timings);
         }
         
+        // Group game managers that produced identical results
+        std::vector<ComparativeGroup> groups;
+        std::map<std::string, size_t> group_index;
+        for (size_t i = 0; i < gm_names.size(); ++i) {
+            if (!gm_results[i]) {
+                std::cerr << "Error: Game manager " << gm_names[i] << " did not produce a result" << std::endl;
+                continue;
+            }
+            const GameResult& result = *gm_results[i];
+            std::string board = renderBoard(result.gameState.get(), map->getWidth(), map->getHeight());
+            
+            std::ostringstream key;
+            key << result.winner << '|' << result.reason << '|' << result.rounds << '|';
+            for (size_t tanks : result.remaining_tanks) {
+                key << tanks << ',';
+            }
+            key << '|' << gm_timings[i][0].timed_out << ',' << gm_timings[i][1].timed_out;
+            key << '|' << board;
+            
+            auto [it, inserted] = group_index.emplace(key.str(), groups.size());
+            if (inserted) {
+                std::string message = resultMessage(result, map->getMaxSteps());
+                // A tank that used up its time limit did nothing since, which the result alone doesn't tell
+                if (gm_timings[i][0].timed_out > 0 || gm_timings[i][1].timed_out > 0) {
+                    message += " (timed out tanks: player 1 has " + std::to_string(gm_timings[i][0].timed_out) +
+                               ", player 2 has " + std::to_string(gm_timings[i][1].timed_out) + ")";
+                }
+                groups.push_back({{}, std::move(message), result.rounds, std::move(board)});
+            }
+            groups[it->second].game_managers.push_back(gm_names[i]);
+        }
+        
+        // Biggest group first, ties keep the order of the first game manager in each group
+        std::stable_sort(groups.begin(), groups.end(), [](const auto& a, const auto& b) {
+            return a.game_managers.size() > b.game_managers.size();
+        });
+        
         // Write results to file
         std::string output_file = args.game_managers_folder + "/comparative_results_" + getCurrentTimeString() + ".txt";
         std::ofstream outfile(output_file);
         if (!outfile.is_open()) {
             std::cerr << "Error: Cannot create output file " << output_file << std::endl;
-            std::cout << "Results would be printed to screen instead:" << std::endl;
-            // Print to screen instead
+            writeComparativeResults(std::cout, args, groups);
             return false;
         }
         
-        outfile << "game_map=" << args.game_map << std::endl;
-        outfile << "algorithm1=" << args.algorithm1 << std::endl;
-        outfile << "algorithm2=" << args.algorithm2 << std::endl;
-        outfile << std::endl;
-        
-        // TODO: Write actual results
-        
+        writeComparativeResults(outfile, args, groups);
         outfile.close();
         return true;
     }
@@ -186,59 +417,274 @@ public:
             return false;
         }
         
-        // Load game maps
+        auto gm_it = game_manager_factories.find(fs::path(args.game_manager).stem().string());
+        if (gm_it == game_manager_factories.end()) {
+            std::cerr << "Error: No game manager found in " << args.game_manager << std::endl;
+            return false;
+        }
+        const GameManagerFactory& gm_factory = gm_it->second;
+        
+        // Load game maps (sorted, since the pairing depends on the map index)
         std::vector<std::string> map_files;
         for (const auto& entry : fs::directory_iterator(args.game_maps_folder)) {
             if (entry.is_regular_file() && entry.path().extension() == ".txt") {
                 map_files.push_back(entry.path().string());
             }
         }
+        std::sort(map_files.begin(), map_files.end());
         
         if (map_files.empty()) {
             std::cerr << "Error: No game maps found in " << args.game_maps_folder << std::endl;
             return false;
         }
         
-        // Competition algorithm pairing as specified in assignment
         std::vector<std::string> algorithm_names;
         for (const auto& [name, _] : algorithm_factories) {
             algorithm_names.push_back(name);
         }
         
-        std::map<std::string, int> scores;
-        for (const auto& name : algorithm_names) {
-            scores[name] = 0;
+        // Indexed like algorithm_names. Games only add to the scores, so relaxed atomics are enough;
+        // pool.run() joining the workers makes the totals visible to this thread.
+        const size_t n = algorithm_names.size();
+        std::vector<std::atomic<int>> scores(n);
+        
+        std::vector<std::string> map_names;
+        for (const auto& map_file : map_files) {
+            map_names.push_back(fs::path(map_file).filename().string());
         }
         
-        // Run competition with proper threading
-        int actual_threads = (args.num_threads == 1) ? 1 : args.num_threads;
-        if (actual_threads == 2) actual_threads = 3; // Assignment: never exactly 2 threads
+        // Contents of the game manager, the algorithms and the maps, which key both the journal and the cache
+        uint64_t gm_hash = 0;
+        std::vector<uint64_t> algorithm_hashes(n);
+        std::vector<uint64_t> map_hashes(map_files.size());
+        bool hashed = ResultCache::hashFile(args.game_manager, gm_hash);
+        for (size_t i = 0; i < n && hashed; ++i) {
+            hashed = ResultCache::hashFile(library_paths[algorithm_names[i]], algorithm_hashes[i]);
+        }
+        for (size_t k = 0; k < map_files.size() && hashed; ++k) {
+            hashed = ResultCache::hashFile(map_files[k], map_hashes[k]);
+        }
         
-        // TODO: Implement competition logic with proper pairing algorithm
+        // Games finished by an earlier run of this same competition are taken from its journal
+        // instead of being played again; the journal is deleted once the results file is written
+        CompetitionJournal journal;
+        const TimedTankAlgorithm::Limits limits = algorithmLimits(args);
+        std::vector<uint64_t> content_hashes = {gm_hash};
+        content_hashes.insert(content_hashes.end(), algorithm_hashes.begin(), algorithm_hashes.end());
+        content_hashes.insert(content_hashes.end(), map_hashes.begin(), map_hashes.end());
+        // Time limits change results too, so a run with other limits doesn't resume this one
+        if (limits.any()) {
+            content_hashes.push_back(static_cast<uint64_t>(limits.per_call.count()));
+            content_hashes.push_back(static_cast<uint64_t>(limits.per_game.count()));
+        }
+        const std::string journal_file = args.algorithms_folder + "/.competition_" +
+            CompetitionJournal::key(args.game_manager, args.game_maps_folder, map_names, algorithm_names,
+                                    content_hashes) + ".journal";
+        if (!hashed || !journal.open(journal_file)) {
+            std::cerr << "Warning: Running without a journal, the competition can't be resumed" << std::endl;
+        } else if (!journal.finishedGames().empty()) {
+            std::cout << "Resuming competition: " << journal.finishedGames().size()
+                      << " finished games read from " << journal_file << std::endl;
+        }
         
-        // Write results to file
-        std::string output_file = args.algorithms_folder + "/competition_" + getCurrentTimeString() + ".txt";
-        std::ofstream outfile(output_file);
-        if (!outfile.is_open()) {
-            std::cerr << "Error: Cannot create output file " << output_file << std::endl;
+        // Games whose game manager, map and algorithms are byte for byte the same as in an earlier
+        // run take their result from the cache; verify_cache plays a random sample of them anyway.
+        // A cached game doesn't run the game manager, so -verbose, which wants every game's output, skips the cache.
+        // So do algorithm time limits, under which the outcome depends on how fast the machine is.
+        ResultCache cache;
+        if (!args.no_cache && !args.verbose && !limits.any()) {
+            if (!hashed || !cache.open(args.algorithms_folder + "/.game_result_cache")) {
+                std::cerr << "Warning: Running without the result cache" << std::endl;
+            }
+        }
+        std::mt19937_64 rng(std::random_device{}());
+        std::bernoulli_distribution verify(args.verify_cache);
+        size_t cached_games = 0;
+        std::atomic<size_t> verified_games{0};
+        std::atomic<size_t> mismatched_games{0};
+        
+        ResultStream result_stream;
+        const size_t num_workers = std::max(1, args.num_threads);
+        if (!args.results_file.empty() && !result_stream.open(args.results_file, num_workers)) {
             return false;
         }
         
-        outfile << "game_maps_folder=" << args.game_maps_folder << std::endl;
-        outfile << "game_manager=" << args.game_manager << std::endl;
-        outfile << std::endl;
+        // Expand every (map x algorithm pair) into its own game.
+        // Competition pairing as specified in assignment: on map k, algorithm i plays (i + 1 + k % (N-1)) % N,
+        // and a pair that comes up twice on the same map is only played once.
+        std::vector<PendingGame> games;
+        for (size_t k = 0; k < map_files.size(); ++k) {
+            const std::string& map_name = map_names[k];
+            std::set<std::pair<size_t, size_t>> pairs;
+            for (size_t i = 0; i < n; ++i) {
+                const size_t j = (i + 1 + k % (n - 1)) % n;
+                pairs.insert({std::min(i, j), std::max(i, j)});
+            }
+            
+            // Count the games the journal already has; the workers aren't running yet, so shard 0 is free
+            for (auto it = pairs.begin(); it != pairs.end();) {
+                const std::string& algo1 = algorithm_names[it->first];
+                const std::string& algo2 = algorithm_names[it->second];
+                auto finished = journal.finishedGames().find({map_name, algo1, algo2});
+                if (finished == journal.finishedGames().end()) {
+                    ++it;
+                    continue;
+                }
+                addScores(scores, it->first, it->second, finished->second.winner);
+                if (result_stream.isOpen()) {
+                    result_stream.add(0, map_name, algo1, algo2, finished->second);
+                }
+                it = pairs.erase(it);
+            }
+            if (pairs.empty()) continue;
+            
+            // Each map is parsed once; its games only read it, so they all share this copy,
+            // which is released when the last of them finishes
+            std::shared_ptr<GameMap> map = GameMap::load(map_files[k]);
+            if (!map) continue;
+            const bool map_cacheable = cache.isOpen();
+            
+            for (const auto& [a, b] : pairs) {
+                const std::string& algo1 = algorithm_names[a];
+                const std::string& algo2 = algorithm_names[b];
+                uint64_t cache_key = 0;
+                std::optional<GameOutcome> cached;
+                if (map_cacheable) {
+                    cache_key = ResultCache::gameKey(gm_hash, map_hashes[k], algorithm_hashes[a], algorithm_hashes[b],
+                                                     map->getMaxSteps(), map->getNumShells());
+                    if (const GameOutcome* hit = cache.find(cache_key)) {
+                        if (!verify(rng)) {
+                            ++cached_games;
+                            addScores(scores, a, b, hit->winner);
+                            if (journal.isOpen()) {
+                                journal.record(map_name, algo1, algo2, *hit);
+                            }
+                            if (result_stream.isOpen()) {
+                                result_stream.add(0, map_name, algo1, algo2, *hit);
+                            }
+                            continue;
+                        }
+                        cached = *hit;
+                    }
+                }
+                
+                games.push_back({map, &map_name, a, b, map_cacheable, cache_key, cached});
+            }
+        }
+        
+        // Latency of the games played under time limits, summed per algorithm
+        std::map<std::string, TimedTankAlgorithm::Timing> timings;
+        std::mutex timings_mutex;
+        
+        // Scores a played game and hands it to the journal, the results file and the cache
+        auto finishGame = [&](const PendingGame& game, const GameOutcome& outcome, const GameTiming& timing,
+                              size_t shard) {
+            const std::string& algo1 = algorithm_names[game.algorithm1];
+            const std::string& algo2 = algorithm_names[game.algorithm2];
+            addScores(scores, game.algorithm1, game.algorithm2, outcome.winner);
+            if (journal.isOpen()) {
+                journal.record(*game.map_name, algo1, algo2, outcome);
+            }
+            if (result_stream.isOpen()) {
+                result_stream.add(shard, *game.map_name, algo1, algo2, outcome);
+            }
+            if (limits.any()) {
+                std::lock_guard<std::mutex> lock(timings_mutex);
+                timings[algo1].merge(timing[0]);
+                timings[algo2].merge(timing[1]);
+            }
+            if (game.cached) {
+                verified_games.fetch_add(1, std::memory_order_relaxed);
+                if (outcome == *game.cached) return;
+                mismatched_games.fetch_add(1, std::memory_order_relaxed);
+                // One write, so messages of different workers don't interleave
+                std::cerr << "Error: " + algo1 + " vs " + algo2 + " on " + *game.map_name +
+                             " no longer gives its cached result\n";
+            }
+            if (game.cacheable) {
+                cache.store(game.cache_key, outcome);
+            }
+        };
+        
+        if (args.isolated) {
+            // num_threads worker processes play the games; their results are finished on this thread
+            std::vector<ProcessPool::Game> tasks;
+            for (const PendingGame& game : games) {
+                tasks.push_back({game.map.get(), static_cast<uint32_t>(game.algorithm1),
+                                 static_cast<uint32_t>(game.algorithm2)});
+            }
+            ProcessPool processes(num_workers, [this, &args, &gm_factory, &algorithm_names, &limits](
+                                                   GameMap& map, uint32_t algorithm1, uint32_t algorithm2) {
+                ProcessPool::Played played;
+                const GameResult result = runGame(gm_factory, map, algorithm_names[algorithm1],
+                                                  algorithm_names[algorithm2], args.verbose, limits, played.timing);
+                played.outcome = outcomeOf(result, played.timing);
+                return played;
+            });
+            const bool played = processes.run(tasks, [&](size_t game, const ProcessPool::Played* played) {
+                const PendingGame& pending = games[game];
+                if (played) {
+                    finishGame(pending, played->outcome, played->timing, 0);
+                } else {
+                    std::cerr << "Error: " << algorithm_names[pending.algorithm1] << " vs "
+                              << algorithm_names[pending.algorithm2] << " on " << *pending.map_name
+                              << " kept crashing its worker process, the game has no result" << std::endl;
+                }
+                games[game].map.reset();
+            });
+            if (!played) {
+                return false;
+            }
+        } else {
+            // num_threads = 1 runs on the main thread; otherwise num_threads workers run while main waits
+            WorkStealingPool pool(num_workers);
+            for (PendingGame& game : games) {
+                pool.submit([this, &args, &gm_factory, &algorithm_names, &limits, &finishGame, &game]() {
+                    GameTiming timing;
+                    const GameResult result = runGame(gm_factory, *game.map, algorithm_names[game.algorithm1],
+                                                      algorithm_names[game.algorithm2], args.verbose, limits, timing);
+                    finishGame(game, outcomeOf(result, timing), timing, WorkStealingPool::currentWorker());
+                    game.map.reset();
+                });
+            }
+            pool.run();
+        }
+        games.clear();
+        
+        journal.close();
+        if (cache.isOpen()) {
+            cache.close();
+            std::cout << "Result cache: " << cached_games << " games taken from the cache, " << verified_games
+                      << " verified, " << mismatched_games << " mismatched" << std::endl;
+        }
+        const bool results_written = result_stream.close();
+        if (limits.any()) {
+            writeLatency(std::cout, timings);
+        }
         
         // Sort algorithms by score
-        std::vector<std::pair<std::string, int>> sorted_scores(scores.begin(), scores.end());
-        std::sort(sorted_scores.begin(), sorted_scores.end(), 
-                  [](const auto& a, const auto& b) { return a.second > b.second; });
+        std::vector<std::pair<std::string, int>> sorted_scores;
+        for (size_t i = 0; i < n; ++i) {
+            sorted_scores.emplace_back(algorithm_names[i], scores[i].load(std::memory_order_relaxed));
+        }
+        std::stable_sort(sorted_scores.begin(), sorted_scores.end(), 
+                         [](const auto& a, const auto& b) { return a.second > b.second; });
         
-        for (const auto& [name, score] : sorted_scores) {
-            outfile << name << " " << score << std::endl;
+        // Write results to file
+        std::string output_file = args.algorithms_folder + "/competition_" + getCurrentTimeString() + ".txt";
+        std::ofstream outfile(output_file);
+        if (!outfile.is_open()) {
+            std::cerr << "Error: Cannot create output file " << output_file << std::endl;
+            writeCompetitionResults(std::cout, args, sorted_scores);
+            return false;
         }
         
+        writeCompetitionResults(outfile, args, sorted_scores);
         outfile.close();
-        return true;
+        if (outfile.good()) {
+            journal.remove();
+        }
+        return results_written && mismatched_games == 0;
     }
 };
 
@@ -268,6 +714,18 @@ CommandLineArgs parseCommandLine(int argc, char* argv[]) {
             args.algorithm1 = arg.substr(11);
         } else if (arg.substr(0, 11) == "algorithm2=") {
             args.algorithm2 = arg.substr(11);
+        } else if (arg == "-isolated") {
+            args.isolated = true;
+        } else if (arg == "-no_cache") {
+            args.no_cache = true;
+        } else if (arg.substr(0, 13) == "verify_cache=") {
+            args.verify_cache = std::stod(arg.substr(13));
+        } else if (arg.substr(0, 13) == "results_file=") {
+            args.results_file = arg.substr(13);
+        } else if (arg.substr(0, 18) == "algorithm_call_ms=") {
+            args.algorithm_call_ms = std::stod(arg.substr(18));
+        } else if (arg.substr(0, 18) == "algorithm_game_ms=") {
+            args.algorithm_game_ms = std::stod(arg.substr(18));
         } else if (arg.substr(0, 12) == "num_threads=") {
             args.num_threads = std::stoi(arg.substr(12));
         }
@@ -279,10 +737,10 @@ CommandLineArgs parseCommandLine(int argc, char* argv[]) {
 void printUsage(const std::string& program_name) {
     std::cout << "Usage:" << std::endl;
     std::cout << "Comparative mode:" << std::endl;
-    std::cout << "  " << program_name << " -comparative game_map=<file> game_managers_folder=<folder> algorithm1=<so> algorithm2=<so> [num_threads=<num>] [-verbose]" << std::endl;
+    std::cout << "  " << program_name << " -comparative game_map=<file> game_managers_folder=<folder> algorithm1=<so> algorithm2=<so> [num_threads=<num>] [algorithm_call_ms=<ms>] [algorithm_game_ms=<ms>] [-verbose]" << std::endl;
     std::cout << std::endl;
     std::cout << "Competition mode:" << std::endl;
-    std::cout << "  " << program_name << " -competition game_maps_folder=<folder> game_manager=<so> algorithms_folder=<folder> [num_threads=<num>] [-verbose]" << std::endl;
+    std::cout << "  " << program_name << " -competition game_maps_folder=<folder> game_manager=<so> algorithms_folder=<folder> [num_threads=<num>] [results_file=<jsonl or csv>] [-no_cache | verify_cache=<fraction>] [algorithm_call_ms=<ms>] [algorithm_game_ms=<ms>] [-isolated] [-verbose]" << std::endl;
 }
 
 bool validateArgs(const CommandLineArgs& args) {
@@ -296,6 +754,11 @@ bool validateArgs(const CommandLineArgs& args) {
         return false;
     }
     
+    if (args.algorithm_call_ms < 0 || args.algorithm_game_ms < 0) {
+        std::cerr << "Error: algorithm_call_ms and algorithm_game_ms can't be negative" << std::endl;
+        return false;
+    }
+    
     if (args.comparative_mode) {
         if (args.game_map.empty()) {
             std::cerr << "Error: Missing required argument: game_map" << std::endl;
@@ -328,6 +791,22 @@ bool validateArgs(const CommandLineArgs& args) {
             std::cerr << "Error: Missing required argument: algorithms_folder" << std::endl;
             return false;
         }
+        if (args.verify_cache < 0 || args.verify_cache > 1) {
+            std::cerr << "Error: verify_cache must be between 0 and 1" << std::endl;
+            return false;
+        }
+        if (args.no_cache && args.verify_cache > 0) {
+            std::cerr << "Error: Cannot specify both -no_cache and verify_cache" << std::endl;
+            return false;
+        }
+        if (args.verbose && args.verify_cache > 0) {
+            std::cerr << "Error: verify_cache has no effect with -verbose, which plays every game" << std::endl;
+            return false;
+        }
+        if ((args.algorithm_call_ms > 0 || args.algorithm_game_ms > 0) && args.verify_cache > 0) {
+            std::cerr << "Error: verify_cache has no effect with algorithm time limits, which play every game" << std::endl;
+            return false;
+        }
     }
     
     return true;
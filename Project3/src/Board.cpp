@@ -51,7 +51,7 @@ bool Board::loadFromFile(const std::string& filename) {
     return true;
 }
 
-char Board::getObjectAt(size_t x, size_t y) const {
+char Board::getObject(size_t x, size_t y) const {
     if (!isValidPosition(x, y)) {
         return '#'; // Return wall for out-of-bounds
     }
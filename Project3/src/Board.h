@@ -39,7 +39,7 @@ public:
     /**
      * SatelliteView interface implementation
      */
-    char getObjectAt(size_t x, size_t y) const override;
+    char getObject(size_t x, size_t y) const override;
     
     /**
      * Get cell type at position
@@ -16,8 +16,8 @@ GameResult GameManager::run(
     size_t num_shells,
     Player& player1, 
     Player& player2,
-    TankAlgorithmFactory player1_tank_algo_factory,
-    TankAlgorithmFactory player2_tank_algo_factory) {
+    TankAlgorithmFactory& player1_tank_algo_factory,
+    TankAlgorithmFactory& player2_tank_algo_factory) {
     
     if (verbose_mode_) {
         std::cout << ">> Starting game with " << map_width << "x" << map_height 
@@ -50,6 +50,7 @@ GameResult GameManager::run(
         // Check if game has ended
         if (checkGameEndConditions()) {
             GameResult result = generateGameResult();
+            result.rounds = turn;
             if (verbose_mode_) {
                 logGameEnd(result);
             }
@@ -59,6 +60,7 @@ GameResult GameManager::run(
     
     // Game ended due to max steps reached
     GameResult result = generateGameResult();
+    result.rounds = max_steps;
     if (verbose_mode_) {
         std::cout << "[INFO] Game ended: Maximum steps (" << max_steps << ") reached\n";
         logGameEnd(result);
@@ -82,7 +84,7 @@ bool GameManager::initializeGameFromMap(SatelliteView& map, size_t map_width, si
     // Scan the map to find tank starting positions and setup board
     for (size_t y = 0; y < map_height; ++y) {
         for (size_t x = 0; x < map_width; ++x) {
-            char cell_char = map.getObjectAt(x, y);
+            char cell_char = map.getObject(x, y);
             CellType cell = CellType::EMPTY; // Default
             
             // Convert character to CellType (this mapping might need adjustment based on actual format)
@@ -281,6 +283,7 @@ void GameManager::updateShells() {
 
 void GameManager::handleCollisions() {
     collision_detector_->detectCollisions();
+    collision_detector_->resolveCollisions();
 }
 
 void GameManager::updateTankStates() {
@@ -437,7 +440,7 @@ void GameManager::displayBoard() {
             
             // Default to board character
             if (!found_tank) {
-                display_char = board.getObjectAt(x, y);
+                display_char = board.getObject(x, y);
             }
             
             std::cout << display_char;
@@ -13,8 +13,8 @@ GameResult VisualizingGameManager::run(
     size_t num_shells,
     Player& player1, 
     Player& player2,
-    TankAlgorithmFactory player1_tank_algo_factory,
-    TankAlgorithmFactory player2_tank_algo_factory) {
+    TankAlgorithmFactory& player1_tank_algo_factory,
+    TankAlgorithmFactory& player2_tank_algo_factory) {
     
     std::cout << "\n=== VISUALIZATION MODE ENABLED ===\n";
     std::cout << "Press ENTER after each turn to continue...\n\n";
@@ -283,7 +283,7 @@ void VisualizingGameManager::displayBoardFromSatelliteView(const SatelliteView&
     for (size_t y = 0; y < height; ++y) {
         std::cout << (y % 10) << "  ";
         for (size_t x = 0; x < width; ++x) {
-            char cell = map.getObjectAt(x, y);
+            char cell = map.getObject(x, y);
             std::cout << getEmojiForChar(cell);
         }
         std::cout << "\n";
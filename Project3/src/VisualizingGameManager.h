@@ -29,8 +29,8 @@ public:
         size_t num_shells,
         Player& player1, 
         Player& player2,
-        TankAlgorithmFactory player1_tank_algo_factory,
-        TankAlgorithmFactory player2_tank_algo_factory) override;
+        TankAlgorithmFactory& player1_tank_algo_factory,
+        TankAlgorithmFactory& player2_tank_algo_factory) override;
 
 protected:
     /**
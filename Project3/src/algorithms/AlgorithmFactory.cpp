@@ -23,11 +23,11 @@ std::unique_ptr<TankAlgorithm> AlgorithmFactory::createRandomAlgorithm(int playe
 
 // Player Factory Implementations
 std::unique_ptr<Player> AlgorithmFactory::createSimplePlayer(int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells) {
-    return std::make_unique<MyPlayer>("SimplePlayer_" + std::to_string(player_index));
+    return std::make_unique<MyPlayer>("SimplePlayer_" + std::to_string(player_index), player_index, x, y, max_steps, num_shells);
 }
 
 std::unique_ptr<Player> AlgorithmFactory::createBfsPlayer(int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells) {
-    return std::make_unique<MyPlayer>("BfsPlayer_" + std::to_string(player_index));
+    return std::make_unique<MyPlayer>("BfsPlayer_" + std::to_string(player_index), player_index, x, y, max_steps, num_shells);
 }
 
 // Function Factory Getters
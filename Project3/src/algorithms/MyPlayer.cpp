@@ -1,7 +1,8 @@
 #include "MyPlayer.h"
 #include "../TankBattleInfo.h"
 
-MyPlayer::MyPlayer(const std::string& name) : name_(name) {
+MyPlayer::MyPlayer(const std::string& name, int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells)
+    : Player(player_index, x, y, max_steps, num_shells), name_(name) {
 }
 
 void MyPlayer::updateTankWithBattleInfo(TankAlgorithm& tank, SatelliteView& satellite_view) {
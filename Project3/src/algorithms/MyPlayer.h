@@ -15,7 +15,7 @@ private:
     std::string name_;
     
 public:
-    explicit MyPlayer(const std::string& name);
+    MyPlayer(const std::string& name, int player_index, size_t x, size_t y, size_t max_steps, size_t num_shells);
     
     /**
      * Update a specific tank algorithm with battle information and satellite view
@@ -2,6 +2,7 @@
 #include "../../src/CellType.h"
 #include <iostream>
 #include <algorithm>
+#include <cmath>
 #include <iomanip>
 
 // Simple test map implementation for tournaments
@@ -12,7 +13,7 @@ private:
 public:
     TournamentMap(size_t width, size_t height) : width_(width), height_(height) {}
     
-    char getObjectAt(size_t x, size_t y) const override {
+    char getObject(size_t x, size_t y) const override {
         // Create a simple map layout
         if (x == 0 || y == 0 || x == width_ - 1 || y == height_ - 1) {
             return '#'; // Wall border
@@ -72,6 +73,7 @@ void TournamentManager::runRoundRobin(int games_per_matchup) {
     std::cout << "Max steps: " << max_steps_ << ", Shells: " << shells_per_tank_ << "\n\n";
     
     tournament_results_.clear();
+    final_standings_.clear();
     
     // Run all possible matchups
     for (size_t i = 0; i < participating_algorithms_.size(); ++i) {
@@ -83,22 +85,290 @@ void TournamentManager::runRoundRobin(int games_per_matchup) {
             std::cout << "─────────────────────────────────────────────\n";
             
             TournamentResult result = runMatchup(algo1, algo2, games_per_matchup);
-            tournament_results_.push_back(result);
-            
             printMatchupResult(result);
             std::cout << "\n";
+            
+            tournament_results_.push_back(std::move(result));
         }
     }
     
     std::cout << "Tournament completed!\n\n";
 }
 
-void TournamentManager::runSingleElimination() {
+namespace {
+
+// 1 if algorithm1 won the matchup, 2 if algorithm2 did, 0 for a tie
+int matchupWinner(const TournamentManager::TournamentResult& result) {
+    if (result.algorithm1_wins > result.algorithm2_wins) return 1;
+    if (result.algorithm2_wins > result.algorithm1_wins) return 2;
+    return 0;
+}
+
+// Seeds (0-based) in bracket order, so that seed 0 and seed 1 can only meet in the final
+std::vector<size_t> bracketOrder(size_t bracket_size) {
+    std::vector<size_t> order = {0};
+    while (order.size() < bracket_size) {
+        std::vector<size_t> next;
+        for (size_t seed : order) {
+            next.push_back(seed);
+            next.push_back(2 * order.size() - 1 - seed);
+        }
+        order = std::move(next);
+    }
+    return order;
+}
+
+// Steps the rematch-free pairing search may take per round; late rounds of a long Swiss can have
+// exponentially many dead ends, so past this the round settles for rematches instead
+constexpr size_t MAX_PAIRING_STEPS = 100000;
+
+// Pairs the players in ranking order without rematches, backtracking when the greedy choice
+// leaves someone without an opponent. last_met[a][b] is the round a and b last played, 0 for never.
+// Returns false if there is no such pairing or the search used up its steps.
+bool pairWithoutRematches(const std::vector<size_t>& unpaired,
+                          const std::vector<std::vector<int>>& last_met,
+                          std::vector<std::pair<size_t, size_t>>& pairs,
+                          size_t& steps_left) {
+    if (unpaired.empty()) return true;
+    
+    const size_t top = unpaired.front();
+    for (size_t i = 1; i < unpaired.size(); ++i) {
+        const size_t candidate = unpaired[i];
+        if (last_met[top][candidate] != 0) continue;
+        if (steps_left == 0) return false;
+        --steps_left;
+        
+        std::vector<size_t> rest;
+        for (size_t j = 1; j < unpaired.size(); ++j) {
+            if (j != i) rest.push_back(unpaired[j]);
+        }
+        pairs.emplace_back(top, candidate);
+        if (pairWithoutRematches(rest, last_met, pairs, steps_left)) return true;
+        pairs.pop_back();
+    }
+    return false;
+}
+
+// Pairs each player in ranking order with the unpaired player it met least recently, preferring
+// ones it never met and then the best ranked. Always succeeds, at the price of rematches.
+std::vector<std::pair<size_t, size_t>> pairLeastRecent(const std::vector<size_t>& order,
+                                                       const std::vector<std::vector<int>>& last_met) {
+    std::vector<std::pair<size_t, size_t>> pairs;
+    std::vector<bool> paired(order.size(), false);
+    for (size_t i = 0; i < order.size(); ++i) {
+        if (paired[i]) continue;
+        size_t best = order.size();
+        for (size_t j = i + 1; j < order.size(); ++j) {
+            if (paired[j]) continue;
+            if (best == order.size() || last_met[order[i]][order[j]] < last_met[order[i]][order[best]]) {
+                best = j;
+            }
+        }
+        if (best == order.size()) break;
+        paired[i] = paired[best] = true;
+        pairs.emplace_back(order[i], order[best]);
+    }
+    return pairs;
+}
+
+} // namespace
+
+void TournamentManager::runSingleElimination(int games_per_matchup) {
     std::cout << "\n🏆 Starting Single Elimination Tournament\n";
     std::cout << "════════════════════════════════════════════\n";
+    std::cout << "Participants: " << participating_algorithms_.size() << " algorithms\n";
+    std::cout << "Games per matchup: " << games_per_matchup << "\n\n";
+    
+    tournament_results_.clear();
+    final_standings_.clear();
+    
+    const size_t num_players = participating_algorithms_.size();
+    if (num_players < 2) {
+        std::cout << "Need at least 2 algorithms for a tournament\n";
+        return;
+    }
+    
+    size_t bracket_size = 1;
+    while (bracket_size < num_players) bracket_size *= 2;
+    
+    // Slots hold seeds; seeds past the field are byes
+    std::vector<size_t> slots = bracketOrder(bracket_size);
+    std::vector<std::vector<size_t>> eliminated_per_round;
+    
+    for (int round = 1; slots.size() > 1; ++round) {
+        std::cout << "🥊 Round " << round << " (" << slots.size() << " slots)\n";
+        std::cout << "─────────────────────────────────────────────\n";
+        
+        std::vector<size_t> advancing;
+        std::vector<size_t> eliminated;
+        for (size_t i = 0; i + 1 < slots.size(); i += 2) {
+            const size_t seed1 = slots[i];
+            const size_t seed2 = slots[i + 1];
+            if (seed2 >= num_players || seed1 >= num_players) {
+                const size_t bye = std::min(seed1, seed2);
+                if (bye < num_players) {
+                    std::cout << participating_algorithms_[bye]->name << " advances on a bye\n";
+                }
+                advancing.push_back(bye);
+                continue;
+            }
+            
+            auto* algo1 = participating_algorithms_[seed1];
+            auto* algo2 = participating_algorithms_[seed2];
+            TournamentResult result = runMatchup(algo1, algo2, games_per_matchup);
+            if (matchupWinner(result) == 0) {
+                runTiebreak(result, algo1, algo2);
+            }
+            printMatchupResult(result);
+            
+            // A matchup still tied after the tiebreak goes to the better seed, which is the lower index
+            const int winner = matchupWinner(result);
+            const bool first_advances = winner == 1 || (winner == 0 && seed1 < seed2);
+            advancing.push_back(first_advances ? seed1 : seed2);
+            eliminated.push_back(first_advances ? seed2 : seed1);
+            if (winner == 0) {
+                std::cout << "   " << participating_algorithms_[advancing.back()]->name
+                          << " advances on seeding\n";
+            }
+            
+            tournament_results_.push_back(std::move(result));
+        }
+        std::cout << "\n";
+        
+        std::sort(eliminated.begin(), eliminated.end());
+        eliminated_per_round.push_back(std::move(eliminated));
+        slots = std::move(advancing);
+    }
     
-    // For now, implement as round robin with single games
-    runRoundRobin(1);
+    // Champion first, then everyone else by how far they got, ties broken by seed
+    final_standings_.push_back(participating_algorithms_[slots.front()]->name);
+    for (auto round = eliminated_per_round.rbegin(); round != eliminated_per_round.rend(); ++round) {
+        for (size_t seed : *round) {
+            final_standings_.push_back(participating_algorithms_[seed]->name);
+        }
+    }
+    
+    std::cout << "🏆 Champion: " << final_standings_.front() << "\n";
+    std::cout << "Tournament completed!\n\n";
+}
+
+void TournamentManager::runSwiss(int rounds, int games_per_matchup) {
+    const size_t num_players = participating_algorithms_.size();
+    if (rounds <= 0) {
+        rounds = 0;
+        while ((size_t{1} << rounds) < num_players) ++rounds;
+    }
+    // Without rematches there are at most n - 1 rounds
+    rounds = static_cast<int>(std::min<size_t>(rounds, num_players > 1 ? num_players - 1 : 0));
+    
+    std::cout << "\n🏆 Starting Swiss Tournament\n";
+    std::cout << "════════════════════════════════════════════\n";
+    std::cout << "Participants: " << num_players << " algorithms\n";
+    std::cout << "Rounds: " << rounds << ", Games per matchup: " << games_per_matchup << "\n\n";
+    
+    tournament_results_.clear();
+    final_standings_.clear();
+    
+    if (num_players < 2) {
+        std::cout << "Need at least 2 algorithms for a tournament\n";
+        return;
+    }
+    
+    std::vector<double> points(num_players, 0.0);
+    std::vector<std::vector<int>> last_met(num_players, std::vector<int>(num_players, 0));
+    std::vector<std::vector<size_t>> opponents(num_players);
+    std::vector<bool> had_bye(num_players, false);
+    
+    // Ranking order: match points, then seed
+    auto ranking = [&]() {
+        std::vector<size_t> order(num_players);
+        for (size_t i = 0; i < num_players; ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return points[a] > points[b]; });
+        return order;
+    };
+    
+    for (int round = 1; round <= rounds; ++round) {
+        std::cout << "🥊 Swiss Round " << round << "/" << rounds << "\n";
+        std::cout << "─────────────────────────────────────────────\n";
+        
+        std::vector<size_t> order = ranking();
+        
+        // The lowest ranked algorithm that hasn't had a bye sits out an odd round, and scores a win
+        if (order.size() % 2 == 1) {
+            auto bye = std::find_if(order.rbegin(), order.rend(), [&](size_t i) { return !had_bye[i]; });
+            const size_t player = bye != order.rend() ? *bye : order.back();
+            had_bye[player] = true;
+            points[player] += 1.0;
+            order.erase(std::find(order.begin(), order.end(), player));
+            std::cout << participating_algorithms_[player]->name << " gets a bye\n";
+        }
+        
+        std::vector<std::pair<size_t, size_t>> pairs;
+        size_t steps_left = MAX_PAIRING_STEPS;
+        if (!pairWithoutRematches(order, last_met, pairs, steps_left)) {
+            std::cout << "No pairing without rematches found, pairing the least recent opponents\n";
+            pairs = pairLeastRecent(order, last_met);
+        }
+        
+        for (const auto& [player1, player2] : pairs) {
+            TournamentResult result = runMatchup(participating_algorithms_[player1],
+                                                 participating_algorithms_[player2],
+                                                 games_per_matchup);
+            printMatchupResult(result);
+            
+            const int winner = matchupWinner(result);
+            points[player1] += winner == 1 ? 1.0 : winner == 0 ? 0.5 : 0.0;
+            points[player2] += winner == 2 ? 1.0 : winner == 0 ? 0.5 : 0.0;
+            last_met[player1][player2] = last_met[player2][player1] = round;
+            opponents[player1].push_back(player2);
+            opponents[player2].push_back(player1);
+            
+            tournament_results_.push_back(std::move(result));
+        }
+        std::cout << "\n";
+    }
+    
+    // Final order: match points, then Buchholz (the opponents' points), then seed
+    std::vector<double> buchholz(num_players, 0.0);
+    for (size_t i = 0; i < num_players; ++i) {
+        for (size_t opponent : opponents[i]) buchholz[i] += points[opponent];
+    }
+    std::vector<size_t> order(num_players);
+    for (size_t i = 0; i < num_players; ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        if (points[a] != points[b]) return points[a] > points[b];
+        return buchholz[a] > buchholz[b];
+    });
+    
+    std::cout << "📊 Swiss Standings\n";
+    for (size_t rank = 0; rank < order.size(); ++rank) {
+        const size_t player = order[rank];
+        final_standings_.push_back(participating_algorithms_[player]->name);
+        std::cout << "  #" << (rank + 1) << " " << participating_algorithms_[player]->name
+                  << " - " << points[player] << " pts (Buchholz " << buchholz[player] << ")\n";
+    }
+    std::cout << "Tournament completed!\n\n";
+}
+
+void TournamentManager::runTiebreak(TournamentResult& result,
+                                    AlgorithmRegistrar::AlgorithmInfo* algo1,
+                                    AlgorithmRegistrar::AlgorithmInfo* algo2) {
+    // Sudden death: single games until one side wins one
+    for (int game = 0; game < MAX_TIEBREAK_GAMES && matchupWinner(result) == 0; ++game) {
+        if (verbose_mode_) {
+            std::cout << "  Tiebreak game " << (game + 1) << ":\n";
+        }
+        TournamentResult extra = runMatchup(algo1, algo2, 1);
+        result.algorithm1_wins += extra.algorithm1_wins;
+        result.algorithm2_wins += extra.algorithm2_wins;
+        result.ties += extra.ties;
+        result.max_games += extra.max_games;
+        result.log_likelihood_ratio += extra.log_likelihood_ratio;
+        for (auto& game_result : extra.individual_results) {
+            result.individual_results.push_back(std::move(game_result));
+        }
+    }
 }
 
 TournamentManager::TournamentResult TournamentManager::runMatchup(
@@ -112,6 +382,16 @@ TournamentManager::TournamentResult TournamentManager::runMatchup(
     result.algorithm1_wins = 0;
     result.algorithm2_wins = 0;
     result.ties = 0;
+    result.max_games = num_games;
+    
+    // Each decisive game moves the log likelihood ratio by a fixed step; the test
+    // stops once it leaves (lower_bound, upper_bound)
+    const double p_high = 0.5 + sprt_margin_;
+    const double p_low = 0.5 - sprt_margin_;
+    const double win_step = std::log(p_high / p_low);
+    const double loss_step = std::log((1.0 - p_high) / (1.0 - p_low));
+    const double upper_bound = std::log((1.0 - sprt_beta_) / sprt_alpha_);
+    const double lower_bound = std::log(sprt_beta_ / (1.0 - sprt_alpha_));
     
     for (int game = 0; game < num_games; ++game) {
         if (verbose_mode_) {
@@ -119,7 +399,6 @@ TournamentManager::TournamentResult TournamentManager::runMatchup(
         }
         
         GameResult game_result = runSingleGame(algo1, algo2);
-        result.individual_results.push_back(game_result);
         
         if (game_result.winner == 1) {
             result.algorithm1_wins++;
@@ -137,6 +416,19 @@ TournamentManager::TournamentResult TournamentManager::runMatchup(
                 std::cout << "Tie!\n";
             }
         }
+        
+        if (game_result.winner == 1) {
+            result.log_likelihood_ratio += win_step;
+        } else if (game_result.winner == 2) {
+            result.log_likelihood_ratio += loss_step;
+        }
+        result.individual_results.push_back(std::move(game_result));
+        
+        if (early_stopping_ && game + 1 < num_games &&
+            (result.log_likelihood_ratio >= upper_bound || result.log_likelihood_ratio <= lower_bound)) {
+            result.stopped_early = true;
+            break;
+        }
     }
     
     return result;
@@ -183,6 +475,12 @@ void TournamentManager::printMatchupResult(const TournamentResult& result) const
         std::cout << " (🤝 Matchup tied)";
     }
     std::cout << "\n";
+    
+    if (early_stopping_) {
+        std::cout << "   SPRT: " << result.individual_results.size() << "/" << result.max_games << " games, LLR "
+                  << std::fixed << std::setprecision(2) << result.log_likelihood_ratio
+                  << (result.stopped_early ? " (decided early)" : "") << "\n";
+    }
 }
 
 void TournamentManager::printTournamentResults() const {
@@ -236,11 +534,21 @@ std::vector<TournamentManager::AlgorithmStats> TournamentManager::calculateAlgor
         stats_vector.push_back(stats);
     }
     
-    // Sort by win rate (descending)
-    std::sort(stats_vector.begin(), stats_vector.end(), 
-              [](const AlgorithmStats& a, const AlgorithmStats& b) {
-                  return a.win_rate > b.win_rate;
-              });
+    // Elimination and Swiss rank by placement; round robin by win rate (descending)
+    if (!final_standings_.empty()) {
+        auto placement = [this](const std::string& name) {
+            return std::find(final_standings_.begin(), final_standings_.end(), name) - final_standings_.begin();
+        };
+        std::stable_sort(stats_vector.begin(), stats_vector.end(),
+                         [&](const AlgorithmStats& a, const AlgorithmStats& b) {
+                             return placement(a.name) < placement(b.name);
+                         });
+    } else {
+        std::sort(stats_vector.begin(), stats_vector.end(), 
+                  [](const AlgorithmStats& a, const AlgorithmStats& b) {
+                      return a.win_rate > b.win_rate;
+                  });
+    }
     
     return stats_vector;
 }
@@ -275,3 +583,19 @@ void TournamentManager::setGameParameters(size_t max_steps, size_t shells_per_ta
     max_steps_ = max_steps;
     shells_per_tank_ = shells_per_tank;
 }
+
+void TournamentManager::setEarlyStopping(bool enabled, double alpha, double beta, double margin) {
+    // Turning it off never fails; the parameters only matter while it is on
+    early_stopping_ = false;
+    if (!enabled) {
+        return;
+    }
+    if (!(alpha > 0.0 && alpha < 0.5) || !(beta > 0.0 && beta < 0.5) || !(margin > 0.0 && margin < 0.5)) {
+        std::cout << "[ERROR] Early stopping needs alpha and beta in (0, 0.5) and margin in (0, 0.5)\n";
+        return;
+    }
+    early_stopping_ = true;
+    sprt_alpha_ = alpha;
+    sprt_beta_ = beta;
+    sprt_margin_ = margin;
+}
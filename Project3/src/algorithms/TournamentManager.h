@@ -24,6 +24,11 @@ public:
         int algorithm2_wins;
         int ties;
         std::vector<GameResult> individual_results;
+        
+        // Sequential test statistics, filled in when early stopping is enabled
+        int max_games = 0;                  ///< Hard cap the matchup could have played
+        bool stopped_early = false;         ///< The test decided before the cap
+        double log_likelihood_ratio = 0.0;  ///< Positive favours algorithm1, negative algorithm2
     };
     
     struct AlgorithmStats {
@@ -43,7 +48,16 @@ private:
     size_t shells_per_tank_;
     bool verbose_mode_;
     
+    // Sequential probability ratio test for early stopping (see setEarlyStopping)
+    bool early_stopping_ = false;
+    double sprt_alpha_ = 0.05;
+    double sprt_beta_ = 0.05;
+    double sprt_margin_ = 0.15;
+    
     std::vector<TournamentResult> tournament_results_;
+    std::vector<std::string> final_standings_; ///< Placement order of the last elimination or Swiss run
+    
+    static constexpr int MAX_TIEBREAK_GAMES = 3; ///< Extra games before a tied elimination matchup goes to the seed
     
 public:
     TournamentManager(size_t map_width = 10, size_t map_height = 10, 
@@ -60,7 +74,19 @@ public:
      * Run tournament
      */
     void runRoundRobin(int games_per_matchup = 3);
-    void runSingleElimination();
+    
+    /**
+     * Seeded knockout bracket in the order the algorithms were added; the top seeds
+     * get byes when the field isn't a power of two. Plays n - 1 matchups.
+     */
+    void runSingleElimination(int games_per_matchup = 1);
+    
+    /**
+     * Swiss system: each round pairs algorithms with equal or nearby match points
+     * (1 per matchup won, 0.5 per tie) without rematches. rounds = 0 plays
+     * ceil(log2 n) rounds, enough to separate the field in about n/2 * log2 n matchups.
+     */
+    void runSwiss(int rounds = 0, int games_per_matchup = 1);
     
     /**
      * Results and statistics
@@ -69,11 +95,27 @@ public:
     std::vector<AlgorithmStats> calculateAlgorithmStats() const;
     void printAlgorithmRankings() const;
     
+    // Matchups of the last run in the order they were played
+    const std::vector<TournamentResult>& getTournamentResults() const { return tournament_results_; }
+    
+    // Placement order of the last elimination or Swiss run; empty after a round robin
+    const std::vector<std::string>& getFinalStandings() const { return final_standings_; }
+    
     /**
      * Configuration
      */
     void setVerbose(bool verbose) { verbose_mode_ = verbose; }
     void setGameParameters(size_t max_steps, size_t shells_per_tank);
+    
+    /**
+     * Stop a matchup as soon as its winner is statistically decided, treating
+     * games_per_matchup as a hard cap. Decisive games feed a sequential
+     * probability ratio test of "algorithm1 wins 0.5 + margin of them" against
+     * "algorithm1 wins 0.5 - margin"; alpha and beta bound the chance of
+     * declaring the wrong one of the two. Ties don't count either way.
+     * The parameters are only checked when enabling; invalid ones leave it off.
+     */
+    void setEarlyStopping(bool enabled, double alpha = 0.05, double beta = 0.05, double margin = 0.15);
 
 private:
     TournamentResult runMatchup(AlgorithmRegistrar::AlgorithmInfo* algo1, 
@@ -83,6 +125,10 @@ private:
     GameResult runSingleGame(AlgorithmRegistrar::AlgorithmInfo* algo1,
                             AlgorithmRegistrar::AlgorithmInfo* algo2);
     
+    void runTiebreak(TournamentResult& result,
+                     AlgorithmRegistrar::AlgorithmInfo* algo1,
+                     AlgorithmRegistrar::AlgorithmInfo* algo2);
+    
     std::unique_ptr<SatelliteView> createTestMap();
     void printMatchupResult(const TournamentResult& result) const;
 };
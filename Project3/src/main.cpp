@@ -28,7 +28,7 @@ public:
         loadFromFile(filename);
     }
     
-    char getObjectAt(size_t x, size_t y) const override {
+    char getObject(size_t x, size_t y) const override {
         if (y >= map_data_.size() || x >= map_data_[y].size()) {
             return '#'; // Wall for out of bounds
         }
@@ -154,6 +154,9 @@ void printUsage(const char* program_name) {
     std::cout << "  -visualize          Enable board visualization\n";
     std::cout << "  -tournament         Run tournament mode\n";
     std::cout << "  -games <num>        Games per tournament matchup (default: 3)\n";
+    std::cout << "  -format <name>      Tournament format: round_robin, elimination or swiss (default: round_robin)\n";
+    std::cout << "  -rounds <num>       Swiss rounds (default: ceil(log2 of the number of algorithms))\n";
+    std::cout << "  -sprt               Stop a matchup once its winner is decided; -games becomes the cap\n";
     std::cout << "  -list               List available algorithms\n";
     std::cout << "  -help               Show this help message\n";
     std::cout << "\nAvailable Algorithms:\n";
@@ -167,6 +170,8 @@ void printUsage(const char* program_name) {
     std::cout << "\nExample:\n";
     std::cout << "  " << program_name << " -map board.txt -algo1 Simple -algo2 BFS -steps 50 -verbose\n";
     std::cout << "  " << program_name << " -tournament -games 5\n";
+    std::cout << "  " << program_name << " -tournament -format swiss -games 1\n";
+    std::cout << "  " << program_name << " -tournament -sprt -games 50\n";
 }
 
 /**
@@ -239,6 +244,9 @@ int main(int argc, char* argv[]) {
     bool visualize = false;
     bool tournament_mode = false;
     int tournament_games = 3;
+    std::string tournament_format = "round_robin";
+    int swiss_rounds = 0;
+    bool early_stopping = false;
     
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
@@ -283,6 +291,18 @@ int main(int argc, char* argv[]) {
             tournament_mode = true;
         } else if (arg == "-games" && i + 1 < argc) {
             tournament_games = std::stoi(argv[++i]);
+        } else if (arg == "-format" && i + 1 < argc) {
+            tournament_format = argv[++i];
+            if (tournament_format != "round_robin" && tournament_format != "elimination" &&
+                tournament_format != "swiss") {
+                std::cerr << "[ERROR] Unknown tournament format: " << tournament_format << std::endl;
+                printUsage(argv[0]);
+                return 1;
+            }
+        } else if (arg == "-rounds" && i + 1 < argc) {
+            swiss_rounds = std::stoi(argv[++i]);
+        } else if (arg == "-sprt") {
+            early_stopping = true;
         } else {
             std::cerr << "[ERROR] Unknown argument: " << arg << std::endl;
             printUsage(argv[0]);
@@ -298,8 +318,15 @@ int main(int argc, char* argv[]) {
         std::cout << "---------------\n";
         
         TournamentManager tournament(10, 10, max_steps, shells_per_tank, verbose);
+        tournament.setEarlyStopping(early_stopping);
         tournament.addAllRegisteredAlgorithms();
-        tournament.runRoundRobin(tournament_games);
+        if (tournament_format == "elimination") {
+            tournament.runSingleElimination(tournament_games);
+        } else if (tournament_format == "swiss") {
+            tournament.runSwiss(swiss_rounds, tournament_games);
+        } else {
+            tournament.runRoundRobin(tournament_games);
+        }
         tournament.printTournamentResults();
         tournament.printAlgorithmRankings();
         
@@ -0,0 +1,206 @@
+#include "Algorithm/LineOfSight.h"
+#include "GameManager/Collision.h"
+#include "GameManager/PositionIndex.h"
+#include "GameManager/Tank.h"
+#include "GameManager/WeakWall.h"
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+bool check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ✓ " : "  ❌ ") << what << "\n";
+    return condition;
+}
+
+using Entries = std::vector<std::pair<int, Position>>;
+
+// Drives an index and a std::map model with the same random inserts, moves and erases, some of them
+// made by the visitor in the middle of a walk. A walk visits, in ascending id order, the entries
+// present when it started that were not erased or moved before the walk reached them.
+bool checkPositionIndex() {
+    constexpr int IDS = 64;
+    std::mt19937 rng(12345);
+    auto randomPosition = [&rng] { return Position(static_cast<int>(rng() % 50), static_cast<int>(rng() % 50)); };
+
+    PositionIndex index;
+    std::map<int, Position> model;
+    auto change = [&](const int id) {
+        if (rng() % 3 == 0) {
+            index.erase(id);
+            model.erase(id);
+        } else {
+            const Position pos = randomPosition();
+            index.insert(id, pos);
+            model[id] = pos;
+        }
+    };
+
+    bool walks_match = true;
+    bool live_walks_match = true;
+    bool contents_match = true;
+    for (int round = 0; round < 2000; ++round) {
+        for (int i = 0, changes = static_cast<int>(rng() % 4); i < changes; ++i) change(static_cast<int>(rng() % IDS));
+
+        const std::map<int, Position> at_start = model;
+        std::set<int> touched;
+        auto expected = at_start.begin();
+        index.forEach([&](const int id, const Position pos) {
+            for (; expected != at_start.end() && expected->first < id; ++expected) {
+                walks_match &= touched.count(expected->first) > 0;
+            }
+            walks_match &= expected != at_start.end() && expected->first == id && expected->second == pos &&
+                           touched.count(id) == 0;
+            if (expected != at_start.end()) ++expected;
+
+            if (rng() % 4 != 0) return;
+            const int other = static_cast<int>(rng() % IDS);
+            change(other);
+            touched.insert(other);
+            // Read-only walks in the middle of a walk already see what it changed
+            Entries live;
+            const PositionIndex& read_only = index;
+            read_only.forEach([&live](const int live_id, const Position live_pos) { live.emplace_back(live_id, live_pos); });
+            live_walks_match &= live == Entries(model.begin(), model.end());
+        });
+        for (; expected != at_start.end(); ++expected) walks_match &= touched.count(expected->first) > 0;
+
+        Entries after;
+        index.forEach([&after](const int id, const Position pos) { after.emplace_back(id, pos); });
+        contents_match &= after == Entries(model.begin(), model.end()) && index.size() == model.size() &&
+                          index.empty() == model.empty();
+    }
+
+    bool ok = check(walks_match, "walks skip entries inserted, or erased or moved before being reached, during the walk");
+    ok &= check(live_walks_match, "read-only walks during a walk see every live entry in id order");
+    ok &= check(contents_match, "after every walk the index holds exactly the model's entries");
+    return ok;
+}
+
+// objectCast<T> must accept exactly the objects dynamic_cast<T *> accepts
+template<typename T>
+bool castsLikeDynamicCast(const std::vector<std::unique_ptr<GameObject>>& objects) {
+    bool same = true;
+    for (const auto& object : objects) {
+        GameObject* raw = object.get();
+        const GameObject* read_only = raw;
+        same &= objectCast<T>(raw) == dynamic_cast<T*>(raw);
+        same &= objectCast<T>(read_only) == dynamic_cast<const T*>(read_only);
+    }
+    return same;
+}
+
+// Every kind of object reports its kind, and the kind-tag casts agree with dynamic_cast on all of them
+bool checkObjectKinds() {
+    std::vector<std::unique_ptr<GameObject>> objects;
+    objects.push_back(std::make_unique<Tank>(Position(1, 1), 1, 0, 0, 5));
+    objects.push_back(std::make_unique<Tank>(Position(2, 1), 2, 0, 0, 5));
+    objects.push_back(std::make_unique<Shell>(Position(1, 2), Direction::LEFT, 1));
+    objects.push_back(std::make_unique<Mine>(Position(1, 3)));
+    objects.push_back(std::make_unique<Wall>(Position(1, 4)));
+    objects.push_back(std::make_unique<WeakWall>(Position(1, 5)));
+    objects.push_back(std::make_unique<Collision>(std::make_unique<Shell>(Position(3, 3), Direction::UP, 1),
+                                                  std::make_unique<Shell>(Position(3, 3), Direction::DOWN, 2)));
+
+    const GameObject* weak_wall = objects[5].get();
+    bool ok = check(objects[0]->isTank() && objects[2]->isShell() && objects[3]->isMine() &&
+                    objects[4]->isWall() && objects[6]->isCollision(),
+                    "each object reports its own kind");
+    ok &= check(weak_wall->isWall() && objectCast<Wall>(weak_wall) != nullptr, "a weak wall is a wall");
+    ok &= check(castsLikeDynamicCast<Tank>(objects) && castsLikeDynamicCast<Shell>(objects) &&
+                castsLikeDynamicCast<Mine>(objects) && castsLikeDynamicCast<Wall>(objects) &&
+                castsLikeDynamicCast<Collision>(objects),
+                "objectCast agrees with dynamic_cast for every kind");
+    ok &= check(objectCast<Tank>(static_cast<GameObject*>(nullptr)) == nullptr, "casting nullptr gives nullptr");
+    return ok;
+}
+
+// The walk line of sight was answered with before the bitboards: step along dir with wraparound
+// until the target is reached or a blocker is in the way
+bool scalarIsClear(const std::vector<bool>& blocked, const size_t width, const size_t height, const Position from,
+                   const Position target, const Direction::DirectionType dir, const size_t max_steps) {
+    const Position delta = Direction::getDirectionDelta(dir);
+    Position pos = from;
+    for (size_t i = 1; i <= max_steps; i++) {
+        pos = Position(static_cast<int>((pos.x + delta.x + width) % width),
+                       static_cast<int>((pos.y + delta.y + height) % height));
+        if (pos == target) return true;
+        if (blocked[pos.y * width + pos.x]) return false;
+    }
+    return false;
+}
+
+// Every query on random boards of several non-square torus sizes, some with lines much longer than
+// either side or a 64-bit word, answers like the scalar walk; one LineOfSight is reset between the sizes
+bool checkLineOfSight() {
+    const std::vector<std::pair<size_t, size_t>> sizes = {{7, 3}, {4, 10}, {6, 9}, {12, 8}, {1, 5}, {13, 2}, {67, 5}, {7, 3}};
+    std::mt19937 rng(2024);
+    LineOfSight reused;
+    bool same = true;
+    size_t queries = 0;
+    for (const auto& [width, height] : sizes) {
+        LineOfSight fresh;
+        fresh.reset(width, height);
+        reused.reset(width, height);
+        std::vector<bool> blocked(width * height);
+        for (size_t cell = 0; cell < blocked.size(); ++cell) {
+            blocked[cell] = rng() % 4 == 0;
+            if (!blocked[cell]) continue;
+            const Position pos(static_cast<int>(cell % width), static_cast<int>(cell / width));
+            fresh.addBlocker(pos);
+            reused.addBlocker(pos);
+        }
+
+        const size_t limits[] = {std::max(width, height), width * height, 1, 3};
+        for (size_t from = 0; from < blocked.size(); ++from) {
+            for (size_t target = 0; target < blocked.size(); ++target) {
+                const Position from_pos(static_cast<int>(from % width), static_cast<int>(from / width));
+                const Position target_pos(static_cast<int>(target % width), static_cast<int>(target / width));
+                for (int d = 0; d < Direction::getDirectionSize(); ++d) {
+                    const auto dir = Direction::getDirectionFromIndex(d);
+                    for (const size_t max_steps : limits) {
+                        const bool expected = scalarIsClear(blocked, width, height, from_pos, target_pos, dir,
+                                                            max_steps);
+                        same &= fresh.isClear(from_pos, target_pos, dir, max_steps) == expected;
+                        same &= reused.isClear(from_pos, target_pos, dir, max_steps) == expected;
+                        ++queries;
+                    }
+                }
+            }
+        }
+    }
+    return check(same, "bitboard line of sight matches the scalar walk on " + std::to_string(queries) +
+                           " queries over non-square boards");
+}
+
+} // namespace
+
+int main() {
+    std::cout << "⚙️ Testing Engine Building Blocks\n";
+    std::cout << "════════════════════════════════\n\n";
+
+    std::cout << "Step 1: Position index\n";
+    std::cout << "──────────────────────\n";
+    bool ok = checkPositionIndex();
+
+    std::cout << "Step 2: Object kinds\n";
+    std::cout << "────────────────────\n";
+    ok &= checkObjectKinds();
+
+    std::cout << "Step 3: Line of sight\n";
+    std::cout << "─────────────────────\n";
+    ok &= checkLineOfSight();
+
+    if (!ok) {
+        std::cout << "❌ Engine building blocks test failed\n";
+        return 1;
+    }
+    std::cout << "🎯 Engine building blocks test completed successfully! ✓\n";
+    return 0;
+}
@@ -0,0 +1,215 @@
+#include "simulator/CompetitionJournal.h"
+#include "simulator/GameMap.h"
+#include "simulator/GameOutcome.h"
+#include "simulator/ProcessPool.h"
+#include "simulator/ResultCache.h"
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+bool check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ✓ " : "  ❌ ") << what << "\n";
+    return condition;
+}
+
+GameOutcome outcome(int winner, GameResult::Reason reason, size_t rounds, size_t tanks1, size_t tanks2) {
+    GameOutcome result;
+    result.winner = winner;
+    result.reason = reason;
+    result.rounds = rounds;
+    result.tanks1 = tanks1;
+    result.tanks2 = tanks2;
+    return result;
+}
+
+void appendRaw(const fs::path& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    out << text;
+}
+
+void writeFile(const fs::path& path, const std::string& text) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out << text;
+}
+
+uint64_t hashOf(const fs::path& path) {
+    uint64_t hash = 0;
+    ResultCache::hashFile(path.string(), hash);
+    return hash;
+}
+
+// A run killed while writing a line leaves it cut short; reopening drops it, keeps every complete
+// game and appends the next game on a line of its own
+bool checkJournalResume(const fs::path& dir) {
+    const fs::path path = dir / "journal.txt";
+    const GameOutcome first = outcome(1, GameResult::ALL_TANKS_DEAD, 42, 2, 0);
+    const GameOutcome second = outcome(0, GameResult::MAX_STEPS, 300, 1, 1);
+    const GameOutcome third = outcome(2, GameResult::ZERO_SHELLS, 77, 0, 3);
+    {
+        CompetitionJournal journal;
+        if (!check(journal.open(path.string()), "a new journal opens")) return false;
+        journal.record("map_a.txt", "Alpha", "Beta", first);
+        journal.record("map_b.txt", "Beta", "Alpha", second);
+    }
+    appendRaw(path, "map_c.txt\tAlpha\tBeta\t1\t0\t3");
+
+    CompetitionJournal journal;
+    bool ok = check(journal.open(path.string()), "a journal with a truncated last line opens");
+    const auto& games = journal.finishedGames();
+    ok &= check(games.size() == 2, "both complete games are resumed and the cut line is dropped");
+    const auto a = games.find({"map_a.txt", "Alpha", "Beta"});
+    const auto b = games.find({"map_b.txt", "Beta", "Alpha"});
+    ok &= check(a != games.end() && a->second == first && b != games.end() && b->second == second,
+                "resumed games keep their outcomes");
+    journal.record("map_c.txt", "Alpha", "Beta", third);
+    journal.close();
+
+    CompetitionJournal reopened;
+    reopened.open(path.string());
+    const auto c = reopened.finishedGames().find({"map_c.txt", "Alpha", "Beta"});
+    ok &= check(reopened.finishedGames().size() == 3 && c != reopened.finishedGames().end() && c->second == third,
+                "the game recorded after the resume is read back whole");
+    reopened.remove();
+    ok &= check(!fs::exists(path), "remove() deletes the journal");
+    return ok;
+}
+
+// Replacing a map or algorithm under the same name starts a new journal
+bool checkJournalKey() {
+    const std::vector<std::string> maps = {"map_a.txt"};
+    const std::vector<std::string> algorithms = {"Alpha", "Beta"};
+    const std::string key = CompetitionJournal::key("gm.so", "maps", maps, algorithms, {1, 2, 3, 4});
+    bool ok = check(key == CompetitionJournal::key("gm.so", "maps", maps, algorithms, {1, 2, 3, 4}),
+                    "the same competition gets the same journal");
+    ok &= check(key != CompetitionJournal::key("gm.so", "maps", maps, algorithms, {1, 2, 3, 5}),
+                "changed file contents get another journal");
+    return ok;
+}
+
+// A stored game is found again by a later run while its inputs are unchanged, and missed once the
+// map or an algorithm library has other contents under the same name
+bool checkCacheHitAndMiss(const fs::path& dir) {
+    const fs::path path = dir / "cache.txt";
+    const fs::path map = dir / "map.txt";
+    const fs::path algorithm = dir / "Alpha.so";
+    writeFile(map, "Test map\nMaxSteps = 100\nNumShells = 5\nRows = 1\nCols = 3\n1 2\n");
+    writeFile(algorithm, "alpha build 1");
+    const uint64_t game_manager = 7;
+    const uint64_t other_algorithm = 11;
+    const GameOutcome played = outcome(1, GameResult::ALL_TANKS_DEAD, 12, 1, 0);
+
+    const uint64_t key = ResultCache::gameKey(game_manager, hashOf(map), hashOf(algorithm), other_algorithm, 100, 5);
+    {
+        ResultCache cache;
+        if (!check(cache.open(path.string()), "a new cache opens")) return false;
+        cache.store(key, played);
+    }
+    // What a run killed while storing leaves behind
+    appendRaw(path, "0123456789abcdef\t2\t0");
+
+    ResultCache cache;
+    bool ok = check(cache.open(path.string()), "the cache opens again after a cut line");
+    const GameOutcome* hit = cache.find(key);
+    ok &= check(hit != nullptr && *hit == played && cache.size() == 1,
+                "unchanged inputs hit the stored outcome and the cut line is dropped");
+    ok &= check(key == ResultCache::gameKey(game_manager, hashOf(map), hashOf(algorithm), other_algorithm, 100, 5),
+                "hashing the same files again gives the same key");
+    ok &= check(cache.find(ResultCache::gameKey(game_manager, hashOf(map), other_algorithm, hashOf(algorithm),
+                                                100, 5)) == nullptr,
+                "swapping who plays first misses");
+
+    writeFile(map, "Test map\nMaxSteps = 100\nNumShells = 5\nRows = 1\nCols = 3\n1#2\n");
+    ok &= check(cache.find(ResultCache::gameKey(game_manager, hashOf(map), hashOf(algorithm), other_algorithm,
+                                                100, 5)) == nullptr,
+                "a map edited under the same name misses");
+    writeFile(map, "Test map\nMaxSteps = 100\nNumShells = 5\nRows = 1\nCols = 3\n1 2\n");
+    writeFile(algorithm, "alpha build 2");
+    ok &= check(cache.find(ResultCache::gameKey(game_manager, hashOf(map), hashOf(algorithm), other_algorithm,
+                                                100, 5)) == nullptr,
+                "a rebuilt algorithm library misses");
+    ok &= check(cache.find(ResultCache::gameKey(game_manager, hashOf(map), hashOf(algorithm), other_algorithm,
+                                                100, 6)) == nullptr,
+                "other map settings miss");
+    return ok;
+}
+
+// A game that kills its worker process every time it is played ends up with no result, while
+// the games queued around it are played by the replacement workers and keep their own results
+bool checkWorkerCrash() {
+    constexpr uint32_t CRASHING = 99;
+    const std::string cells = "1  2";
+    const auto map = GameMap::fromCells(4, 1, 50, 3, cells.data());
+
+    std::vector<ProcessPool::Game> games;
+    for (uint32_t i = 0; i < 8; ++i) {
+        games.push_back({map.get(), i == 3 ? CRASHING : i, i + 1});
+    }
+    ProcessPool pool(2, [](GameMap& played_map, uint32_t algorithm1, uint32_t algorithm2) {
+        if (algorithm1 == CRASHING) raise(SIGKILL);
+        ProcessPool::Played played;
+        played.outcome = outcome(1, GameResult::ALL_TANKS_DEAD, algorithm1 * 10 + algorithm2, played_map.getWidth(), 0);
+        played.timing[1].calls = algorithm2;
+        return played;
+    });
+
+    std::vector<int> reported(games.size(), 0);
+    std::vector<bool> correct(games.size(), false);
+    const bool ran = pool.run(games, [&](size_t game, const ProcessPool::Played* played) {
+        reported[game]++;
+        correct[game] = game == 3
+                            ? played == nullptr
+                            : played != nullptr && played->outcome.rounds == games[game].algorithm1 * 10 + game + 1 &&
+                              played->outcome.tanks1 == 4 && played->timing[1].calls == game + 1;
+    });
+
+    bool ok = check(ran, "the worker processes start");
+    bool once = true;
+    for (const int count : reported) once &= count == 1;
+    ok &= check(once, "every game is reported exactly once");
+    ok &= check(correct[3], "the game that kept crashing its worker has no result");
+    bool others = true;
+    for (size_t i = 0; i < games.size(); ++i) others &= i == 3 || correct[i];
+    ok &= check(others, "the other games come back with their own outcomes and timings");
+    return ok;
+}
+
+} // namespace
+
+int main() {
+    std::cout << "🗂️ Testing Simulator Bookkeeping\n";
+    std::cout << "════════════════════════════════\n\n";
+
+    const fs::path dir = fs::temp_directory_path() / ("tank_test_simulator_" + std::to_string(getpid()));
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    std::cout << "Step 1: Competition journal\n";
+    std::cout << "───────────────────────────\n";
+    bool ok = checkJournalResume(dir);
+    ok &= checkJournalKey();
+
+    std::cout << "Step 2: Result cache\n";
+    std::cout << "────────────────────\n";
+    ok &= checkCacheHitAndMiss(dir);
+
+    std::cout << "Step 3: Worker processes\n";
+    std::cout << "────────────────────────\n";
+    ok &= checkWorkerCrash();
+
+    fs::remove_all(dir);
+    if (!ok) {
+        std::cout << "❌ Simulator bookkeeping test failed\n";
+        return 1;
+    }
+    std::cout << "🎯 Simulator bookkeeping test completed successfully! ✓\n";
+    return 0;
+}
@@ -1,6 +1,155 @@
 #include "src/algorithms/TournamentManager.h"
 #include "src/algorithms/AlgorithmFactory.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+
+bool check(bool condition, const std::string& what) {
+    std::cout << (condition ? "  ✓ " : "  ❌ ") << what << "\n";
+    return condition;
+}
+
+// Registers Entrant_1 .. Entrant_<count>, copies of Simple; must happen before any addAlgorithm,
+// which keeps pointers into the registry
+void registerEntrants(int count) {
+    for (int i = 1; i <= count; ++i) {
+        AlgorithmRegistrar::registerAlgorithm("Entrant_" + std::to_string(i), "Copy of Simple for bracket tests",
+                                              AlgorithmFactory::getSimpleAlgorithmFactory(),
+                                              AlgorithmFactory::getSimplePlayerFactory());
+    }
+}
+
+// Plays a fixed list of actions, then keeps repeating the last one
+class ScriptedAlgorithm : public TankAlgorithm {
+private:
+    std::vector<ActionRequest> script_;
+    size_t next_ = 0;
+    
+public:
+    explicit ScriptedAlgorithm(std::vector<ActionRequest> script) : script_(std::move(script)) {}
+    
+    ActionRequest getAction() override {
+        return next_ < script_.size() ? script_[next_++] : script_.back();
+    }
+    
+    void updateBattleInfo(BattleInfo& /* info */) override {}
+};
+
+TankAlgorithmFactory scriptedFactory(std::vector<ActionRequest> script) {
+    return [script](int /* player_index */, int /* tank_index */) -> std::unique_ptr<TankAlgorithm> {
+        return std::make_unique<ScriptedAlgorithm>(script);
+    };
+}
+
+// Registers Hunter, which drives from (1,1) into the row of the tank at (8,8) on a 10x10 map and
+// shoots it, and Sitter, which never moves; as player 1 Hunter wins every game against Sitter
+void registerScriptedAlgorithms() {
+    std::vector<ActionRequest> hunt = {ActionRequest::RotateRight90, ActionRequest::RotateRight90};
+    hunt.insert(hunt.end(), 7, ActionRequest::MoveForward);
+    hunt.push_back(ActionRequest::RotateLeft90);
+    hunt.push_back(ActionRequest::MoveForward);
+    hunt.push_back(ActionRequest::Shoot);
+    AlgorithmRegistrar::registerAlgorithm("Hunter", "Scripted shooter for early stopping tests",
+                                          scriptedFactory(hunt), AlgorithmFactory::getSimplePlayerFactory());
+    AlgorithmRegistrar::registerAlgorithm("Sitter", "Scripted idle tank for early stopping tests",
+                                          scriptedFactory({ActionRequest::DoNothing}),
+                                          AlgorithmFactory::getSimplePlayerFactory());
+}
+
+std::pair<std::string, std::string> pairing(const TournamentManager::TournamentResult& result) {
+    return std::minmax(result.algorithm1_name, result.algorithm2_name);
+}
+
+// 5 entrants in an 8 bracket: seeds 1-3 get byes, seed 4 plays seed 5, then 1 meets that winner and 2 meets 3
+bool checkEliminationBracket() {
+    TournamentManager tournament(10, 10, 30, 3, false);
+    for (int i = 1; i <= 5; ++i) tournament.addAlgorithm("Entrant_" + std::to_string(i));
+    tournament.runSingleElimination(1);
+    
+    const auto& results = tournament.getTournamentResults();
+    const auto& standings = tournament.getFinalStandings();
+    bool ok = check(results.size() == 4, "elimination plays n - 1 matchups");
+    if (!ok) return false;
+    ok &= check(pairing(results[0]) == std::make_pair(std::string("Entrant_4"), std::string("Entrant_5")),
+                "only seeds 4 and 5 play in round 1, seeds 1-3 have byes");
+    ok &= check(results[1].algorithm1_name == "Entrant_1" &&
+                (results[1].algorithm2_name == "Entrant_4" || results[1].algorithm2_name == "Entrant_5"),
+                "seed 1 meets the winner of 4 vs 5");
+    ok &= check(pairing(results[2]) == std::make_pair(std::string("Entrant_2"), std::string("Entrant_3")),
+                "seed 2 meets seed 3");
+    ok &= check(standings.size() == 5 && std::set<std::string>(standings.begin(), standings.end()).size() == 5,
+                "every entrant is placed once");
+    ok &= check(!standings.empty() && (standings[0] == results[3].algorithm1_name ||
+                                       standings[0] == results[3].algorithm2_name),
+                "the champion played the final");
+    return ok;
+}
+
+// Swiss rounds never repeat a pairing when one without rematches exists, and stay fast when
+// every round has to be checked against all earlier ones
+bool checkSwissPairings() {
+    TournamentManager tournament(10, 10, 30, 3, false);
+    for (int i = 1; i <= 8; ++i) tournament.addAlgorithm("Entrant_" + std::to_string(i));
+    tournament.runSwiss(0, 1);
+    
+    std::set<std::pair<std::string, std::string>> seen;
+    bool rematch = false;
+    for (const auto& result : tournament.getTournamentResults()) {
+        rematch |= !seen.insert(pairing(result)).second;
+    }
+    bool ok = check(tournament.getTournamentResults().size() == 12, "8 entrants play 3 rounds of 4 matchups");
+    ok &= check(!rematch, "no pairing is repeated");
+    
+    TournamentManager full(10, 10, 10, 1, false);
+    for (int i = 1; i <= 32; ++i) full.addAlgorithm("Entrant_" + std::to_string(i));
+    const auto start = std::chrono::steady_clock::now();
+    full.runSwiss(31, 1);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    ok &= check(full.getTournamentResults().size() == 31 * 16, "32 entrants play all 31 rounds");
+    ok &= check(elapsed < std::chrono::seconds(60), "31 Swiss rounds finish without an exhaustive pairing search");
+    return ok;
+}
+
+// A one-sided matchup ends once the test is sure of the winner, well before the cap, and turning
+// early stopping off works even with parameters it would reject
+bool checkEarlyStopping() {
+    TournamentManager tournament(10, 10, 30, 3, false);
+    tournament.addAlgorithm("Hunter");
+    tournament.addAlgorithm("Sitter");
+    tournament.setEarlyStopping(true);
+    tournament.runRoundRobin(20);
+    
+    const auto& results = tournament.getTournamentResults();
+    bool ok = check(results.size() == 1, "two entrants play one matchup");
+    if (!ok) return false;
+    const auto& result = results[0];
+    ok &= check(result.algorithm1_wins == static_cast<int>(result.individual_results.size()),
+                "Hunter wins every game it plays");
+    ok &= check(result.stopped_early && result.individual_results.size() == 5,
+                "the matchup stops after 5 straight wins");
+    ok &= check(result.max_games == 20, "the result keeps the cap of 20 games");
+    ok &= check(result.log_likelihood_ratio >= std::log(19.0), "the test statistic passed the upper bound");
+    
+    TournamentManager disabled(10, 10, 30, 3, false);
+    disabled.addAlgorithm("Hunter");
+    disabled.addAlgorithm("Sitter");
+    disabled.setEarlyStopping(true);
+    disabled.setEarlyStopping(false, 0.0, 1.0, 0.7);
+    disabled.runRoundRobin(8);
+    ok &= check(!disabled.getTournamentResults().empty() &&
+                disabled.getTournamentResults()[0].individual_results.size() == 8 &&
+                !disabled.getTournamentResults()[0].stopped_early,
+                "disabling with invalid parameters still plays every game");
+    return ok;
+}
+
+} // namespace
 
 int main() {
     std::cout << "🏆 Testing Tournament System\n";
@@ -11,6 +160,8 @@ int main() {
         std::cout << "Step 1: Setting up algorithms\n";
         std::cout << "─────────────────────────────\n";
         AlgorithmRegistrar::registerDefaultAlgorithms();
+        registerEntrants(32);
+        registerScriptedAlgorithms();
         
         // Create tournament manager
         std::cout << "Step 2: Creating tournament\n";
@@ -35,6 +186,22 @@ int main() {
         tournament.printTournamentResults();
         tournament.printAlgorithmRankings();
         
+        std::cout << "Step 6: Single elimination bracket\n";
+        std::cout << "──────────────────────────────────\n";
+        bool ok = checkEliminationBracket();
+        
+        std::cout << "Step 7: Swiss pairings\n";
+        std::cout << "──────────────────────\n";
+        ok &= checkSwissPairings();
+        
+        std::cout << "Step 8: Early stopping\n";
+        std::cout << "──────────────────────\n";
+        ok &= checkEarlyStopping();
+        
+        if (!ok) {
+            std::cout << "❌ Tournament system test failed\n";
+            return 1;
+        }
         std::cout << "🎯 Tournament system test completed successfully! ✓\n";
         
     } catch (const std::exception& e) {